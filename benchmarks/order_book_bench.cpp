@@ -0,0 +1,400 @@
+#include <benchmark/benchmark.h>
+#include "order_book/order_book.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// =========================================================================
+// OrderBook Microbenchmarks
+// =========================================================================
+//
+// Every benchmark runs against both book variants (std::map levels and the tick ladder)
+// and most take the book shape as arguments: {levels per side, orders per level}.
+// Books log into a NullSink and skip invariant checks, so only the book itself is timed.
+// Benchmarks that use up the book rebuild it with the timer paused.
+
+namespace {
+
+constexpr Price TICK = 0.01;
+constexpr Price BEST_BID = 100.00;
+constexpr Price BEST_ASK = 100.01;
+constexpr Quantity ORDER_QUANTITY = 10;
+
+const LadderConfig LADDER{TICK, 0.01, 200.0};
+
+enum class BookKind { MAP, LADDER };
+
+std::unique_ptr<OrderBook> make_book(BookKind kind) {
+    auto sink = std::make_shared<NullSink>();
+    auto book = kind == BookKind::LADDER ? std::make_unique<OrderBook>(LADDER, sink)
+                                         : std::make_unique<OrderBook>(sink);
+    book->set_invariant_mode(InvariantMode::OFF);
+    return book;
+}
+
+Order limit_order(OrderID order_id, OrderSide side, Price price, Quantity quantity = ORDER_QUANTITY) {
+    Order order{};
+    order.order_id = order_id;
+    order.trader_id = 1;
+    order.price = price;
+    order.quantity = quantity;
+    order.side = side;
+    order.type = OrderType::LIMIT;
+    return order;
+}
+
+Order market_order(OrderID order_id, OrderSide side, Quantity quantity) {
+    Order order{};
+    order.order_id = order_id;
+    order.trader_id = 2;
+    order.quantity = quantity;
+    order.side = side;
+    order.type = OrderType::MARKET;
+    return order;
+}
+
+Price bid_price(std::int64_t level) { return BEST_BID - static_cast<Price>(level) * TICK; }
+Price ask_price(std::int64_t level) { return BEST_ASK + static_cast<Price>(level) * TICK; }
+
+// Both sides filled level by level, ids 1..2 * levels * orders_per_level; returns the next free id
+OrderID fill_book(OrderBook& book, std::int64_t levels, std::int64_t orders_per_level) {
+    OrderID order_id = 1;
+    for (std::int64_t level = 0; level < levels; ++level) {
+        for (std::int64_t i = 0; i < orders_per_level; ++i) {
+            book.place_limit_order(limit_order(order_id++, OrderSide::BUY, bid_price(level)));
+            book.place_limit_order(limit_order(order_id++, OrderSide::SELL, ask_price(level)));
+        }
+    }
+    return order_id;
+}
+
+void book_shapes(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"levels", "orders"});
+    for (std::int64_t levels : {1, 10, 100, 1000}) {
+        for (std::int64_t orders : {1, 10, 100}) {
+            if (levels * orders <= 10000) {
+                bench->Args({levels, orders});
+            }
+        }
+    }
+}
+
+// =========================================================================
+// Order entry
+// =========================================================================
+
+// Passive limit order joining the back of an existing bid level
+template <BookKind Kind>
+void BM_PlaceLimitPassive(benchmark::State& state) {
+    const std::int64_t levels = state.range(0);
+    const std::int64_t orders_per_level = state.range(1);
+    auto book = make_book(Kind);
+    OrderID first_id = fill_book(*book, levels, orders_per_level);
+    OrderID order_id = first_id;
+    std::int64_t level = 0;
+
+    for (auto _ : state) {
+        book->place_limit_order(limit_order(order_id++, OrderSide::BUY, bid_price(level)));
+        if (++level == levels) {
+            level = 0;
+        }
+        // Keep the book shape stable: take the added orders out again every 4096 placements
+        if (order_id - first_id == 4096) {
+            state.PauseTiming();
+            for (OrderID id = first_id; id < order_id; ++id) {
+                book->cancel_order(id);
+            }
+            first_id = order_id;
+            state.ResumeTiming();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Aggressive limit order filling exactly the order at the front of the best ask
+template <BookKind Kind>
+void BM_PlaceLimitCrossing(benchmark::State& state) {
+    const std::int64_t levels = state.range(0);
+    const std::int64_t orders_per_level = state.range(1);
+    const std::int64_t resting = levels * orders_per_level;
+    auto book = make_book(Kind);
+    OrderID order_id = fill_book(*book, levels, orders_per_level);
+    std::int64_t filled = 0;
+
+    for (auto _ : state) {
+        std::int64_t level = filled / orders_per_level;
+        book->place_limit_order(limit_order(order_id++, OrderSide::BUY, ask_price(level)));
+        if (++filled == resting) {
+            state.PauseTiming();
+            book = make_book(Kind);
+            order_id = fill_book(*book, levels, orders_per_level);
+            filled = 0;
+            state.ResumeTiming();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Market order sweeping `swept` whole levels of a deep book
+template <BookKind Kind>
+void BM_PlaceMarketSweep(benchmark::State& state) {
+    const std::int64_t swept = state.range(0);
+    const std::int64_t orders_per_level = state.range(1);
+    const std::int64_t levels = 1024;
+    const Quantity quantity = static_cast<Quantity>(swept * orders_per_level) * ORDER_QUANTITY;
+    auto book = make_book(Kind);
+    OrderID order_id = fill_book(*book, levels, orders_per_level);
+    std::int64_t remaining = levels;
+
+    for (auto _ : state) {
+        book->place_market_order(market_order(order_id++, OrderSide::BUY, quantity));
+        remaining -= swept;
+        if (remaining < swept) {
+            state.PauseTiming();
+            book = make_book(Kind);
+            order_id = fill_book(*book, levels, orders_per_level);
+            remaining = levels;
+            state.ResumeTiming();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * swept * orders_per_level);
+}
+
+void sweep_shapes(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"swept", "orders"});
+    for (std::int64_t swept : {1, 4, 16, 64}) {
+        for (std::int64_t orders : {1, 10}) {
+            bench->Args({swept, orders});
+        }
+    }
+}
+
+// =========================================================================
+// Cancel and modify
+// =========================================================================
+
+enum class QueuePosition { FRONT, MIDDLE, BACK };
+
+// Cancel inside one deep bid level, in an order that keeps hitting the given queue position
+template <BookKind Kind, QueuePosition Position>
+void BM_Cancel(benchmark::State& state) {
+    const std::int64_t orders_per_level = state.range(0);
+    auto book = make_book(Kind);
+    std::vector<OrderID> cancel_order;
+
+    auto rebuild = [&]() {
+        book = make_book(Kind);
+        cancel_order.clear();
+        for (std::int64_t i = 0; i < orders_per_level; ++i) {
+            book->place_limit_order(limit_order(static_cast<OrderID>(i + 1), OrderSide::BUY, BEST_BID));
+        }
+        if (Position == QueuePosition::FRONT) {
+            for (std::int64_t i = 0; i < orders_per_level; ++i) {
+                cancel_order.push_back(static_cast<OrderID>(i + 1));
+            }
+        } else if (Position == QueuePosition::BACK) {
+            for (std::int64_t i = orders_per_level; i > 0; --i) {
+                cancel_order.push_back(static_cast<OrderID>(i));
+            }
+        } else {
+            // From the centre outwards, alternating sides, so every cancel hits the middle
+            std::int64_t left = (orders_per_level - 1) / 2;
+            std::int64_t right = left + 1;
+            while (left >= 0 || right < orders_per_level) {
+                if (left >= 0) {
+                    cancel_order.push_back(static_cast<OrderID>(left-- + 1));
+                }
+                if (right < orders_per_level) {
+                    cancel_order.push_back(static_cast<OrderID>(right++ + 1));
+                }
+            }
+        }
+    };
+
+    rebuild();
+    std::size_t next = 0;
+    for (auto _ : state) {
+        book->cancel_order(cancel_order[next]);
+        if (++next == cancel_order.size()) {
+            state.PauseTiming();
+            rebuild();
+            next = 0;
+            state.ResumeTiming();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void level_depths(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"orders"});
+    for (std::int64_t orders : {16, 256, 4096}) {
+        bench->Arg(orders);
+    }
+}
+
+// Same price, smaller quantity: reduced in place, keeps queue priority
+template <BookKind Kind>
+void BM_ModifyReduce(benchmark::State& state) {
+    const std::int64_t levels = state.range(0);
+    const std::int64_t orders_per_level = state.range(1);
+    const Quantity start_quantity = 1u << 30;
+    auto book = make_book(Kind);
+    fill_book(*book, levels, orders_per_level);
+    OrderID target = 1;
+    book->modify_order(target, bid_price(0), start_quantity);  // Requeued once with room to shrink
+    Quantity quantity = start_quantity;
+
+    for (auto _ : state) {
+        book->modify_order(target, bid_price(0), --quantity);
+        if (quantity == 1) {
+            state.PauseTiming();
+            book->modify_order(target, bid_price(0), start_quantity);
+            quantity = start_quantity;
+            state.ResumeTiming();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Price change: the order leaves its level and is requeued at the back of another one
+template <BookKind Kind>
+void BM_ModifyReprice(benchmark::State& state) {
+    const std::int64_t levels = state.range(0);
+    const std::int64_t orders_per_level = state.range(1);
+    auto book = make_book(Kind);
+    fill_book(*book, levels, orders_per_level);
+    const OrderID bid_orders = static_cast<OrderID>(levels * orders_per_level);
+    OrderID target = 0;
+    std::int64_t level = 0;
+
+    for (auto _ : state) {
+        // Bids have the odd ids, cycle through them and through the levels
+        book->modify_order(2 * target + 1, bid_price(level), ORDER_QUANTITY);
+        target = (target + 1) % bid_orders;
+        if (++level == levels) {
+            level = 0;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// =========================================================================
+// Market data queries
+// =========================================================================
+
+template <BookKind Kind>
+void BM_Level1(benchmark::State& state) {
+    auto book = make_book(Kind);
+    fill_book(*book, state.range(0), state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book->get_level1_data());
+    }
+}
+
+template <BookKind Kind>
+void BM_Level2(benchmark::State& state) {
+    auto book = make_book(Kind);
+    fill_book(*book, state.range(0), state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book->get_level2_data());
+    }
+}
+
+template <BookKind Kind>
+void BM_Snapshot(benchmark::State& state) {
+    auto book = make_book(Kind);
+    fill_book(*book, state.range(0), state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book->get_snapshot(0));
+    }
+}
+
+template <BookKind Kind>
+void BM_BidLevels10(benchmark::State& state) {
+    auto book = make_book(Kind);
+    fill_book(*book, state.range(0), state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book->get_bid_levels(10));
+    }
+}
+
+template <BookKind Kind>
+void BM_FillDepth10(benchmark::State& state) {
+    auto book = make_book(Kind);
+    fill_book(*book, state.range(0), state.range(1));
+    DepthN<10> depth{};
+    for (auto _ : state) {
+        book->fill_depth(depth);
+        benchmark::DoNotOptimize(depth);
+    }
+}
+
+template <BookKind Kind>
+void BM_DepthAtPrice(benchmark::State& state) {
+    const std::int64_t levels = state.range(0);
+    auto book = make_book(Kind);
+    fill_book(*book, levels, state.range(1));
+    std::int64_t level = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book->get_depth_at_price(bid_price(level), OrderSide::BUY));
+        if (++level == levels) {
+            level = 0;
+        }
+    }
+}
+
+template <BookKind Kind>
+void BM_SpreadAndMid(benchmark::State& state) {
+    auto book = make_book(Kind);
+    fill_book(*book, state.range(0), state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book->get_spread());
+        benchmark::DoNotOptimize(book->get_mid_price());
+    }
+}
+
+// Add + cancel (two level changes) and a Level 2 delta poll per iteration, compare with
+// BM_Level2 plus the cost of an add and a cancel
+template <BookKind Kind>
+void BM_Level2Updates(benchmark::State& state) {
+    auto book = make_book(Kind);
+    book->enable_level2_updates();
+    OrderID order_id = fill_book(*book, state.range(0), state.range(1));
+    std::uint64_t sequence = book->get_level2_updates(0).sequence;
+    for (auto _ : state) {
+        book->place_limit_order(limit_order(order_id, OrderSide::BUY, bid_price(0)));
+        book->cancel_order(order_id++);
+        Level2Updates updates = book->get_level2_updates(sequence);
+        sequence = updates.sequence;
+        benchmark::DoNotOptimize(updates);
+    }
+}
+
+}  // namespace
+
+#define ORDER_BOOK_BENCHMARK(name, shapes)                                      \
+    BENCHMARK_TEMPLATE(name, BookKind::MAP)->Name(#name "/map")->Apply(shapes); \
+    BENCHMARK_TEMPLATE(name, BookKind::LADDER)->Name(#name "/ladder")->Apply(shapes)
+
+ORDER_BOOK_BENCHMARK(BM_PlaceLimitPassive, book_shapes);
+ORDER_BOOK_BENCHMARK(BM_PlaceLimitCrossing, book_shapes);
+ORDER_BOOK_BENCHMARK(BM_PlaceMarketSweep, sweep_shapes);
+ORDER_BOOK_BENCHMARK(BM_ModifyReduce, book_shapes);
+ORDER_BOOK_BENCHMARK(BM_ModifyReprice, book_shapes);
+ORDER_BOOK_BENCHMARK(BM_Level1, book_shapes);
+ORDER_BOOK_BENCHMARK(BM_Level2, book_shapes);
+ORDER_BOOK_BENCHMARK(BM_Snapshot, book_shapes);
+ORDER_BOOK_BENCHMARK(BM_BidLevels10, book_shapes);
+ORDER_BOOK_BENCHMARK(BM_FillDepth10, book_shapes);
+ORDER_BOOK_BENCHMARK(BM_DepthAtPrice, book_shapes);
+ORDER_BOOK_BENCHMARK(BM_SpreadAndMid, book_shapes);
+ORDER_BOOK_BENCHMARK(BM_Level2Updates, book_shapes);
+
+BENCHMARK_TEMPLATE(BM_Cancel, BookKind::MAP, QueuePosition::FRONT)->Name("BM_Cancel/map/front")->Apply(level_depths);
+BENCHMARK_TEMPLATE(BM_Cancel, BookKind::MAP, QueuePosition::MIDDLE)->Name("BM_Cancel/map/middle")->Apply(level_depths);
+BENCHMARK_TEMPLATE(BM_Cancel, BookKind::MAP, QueuePosition::BACK)->Name("BM_Cancel/map/back")->Apply(level_depths);
+BENCHMARK_TEMPLATE(BM_Cancel, BookKind::LADDER, QueuePosition::FRONT)->Name("BM_Cancel/ladder/front")->Apply(level_depths);
+BENCHMARK_TEMPLATE(BM_Cancel, BookKind::LADDER, QueuePosition::MIDDLE)->Name("BM_Cancel/ladder/middle")->Apply(level_depths);
+BENCHMARK_TEMPLATE(BM_Cancel, BookKind::LADDER, QueuePosition::BACK)->Name("BM_Cancel/ladder/back")->Apply(level_depths);
+
+BENCHMARK_MAIN();
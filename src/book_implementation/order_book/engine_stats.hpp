@@ -0,0 +1,238 @@
+#pragma once
+#include "latency_histogram.hpp"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define ORDER_BOOK_HAS_TSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define ORDER_BOOK_HAS_TSC 1
+#else
+#define ORDER_BOOK_HAS_TSC 0
+#endif
+
+// Compile the per-operation instrumentation into OrderBook with -DORDER_BOOK_ENGINE_STATS=1
+#ifndef ORDER_BOOK_ENGINE_STATS
+#define ORDER_BOOK_ENGINE_STATS 0
+#endif
+
+// =========================================================================
+// Engine Statistics
+// =========================================================================
+
+// Instrumented OrderBook entry points
+enum class EngineOp : std::uint8_t {
+    PLACE_LIMIT,
+    PLACE_MARKET,
+    CANCEL,
+    MODIFY,
+    SNAPSHOT,    // get_snapshot
+    LEVEL1,      // get_level1_data
+    LEVEL2,      // get_level2_data, copy_levels, fill_depth
+    COUNT
+};
+
+inline const char* engine_op_name(EngineOp op) {
+    switch (op) {
+        case EngineOp::PLACE_LIMIT: return "limit";
+        case EngineOp::PLACE_MARKET: return "market";
+        case EngineOp::CANCEL: return "cancel";
+        case EngineOp::MODIFY: return "modify";
+        case EngineOp::SNAPSHOT: return "snapshot";
+        case EngineOp::LEVEL1: return "level1";
+        case EngineOp::LEVEL2: return "level2";
+        default: return "unknown";
+    }
+}
+
+// Count, mean and percentiles of one recorded distribution
+struct DistributionSummary {
+    std::uint64_t count = 0;
+    std::uint64_t min = 0;
+    double mean = 0.0;
+    std::uint64_t p50 = 0;
+    std::uint64_t p90 = 0;
+    std::uint64_t p99 = 0;
+    std::uint64_t p999 = 0;
+    std::uint64_t max = 0;
+};
+
+inline DistributionSummary summarize(const LatencyHistogram& histogram) {
+    DistributionSummary summary;
+    summary.count = histogram.count();
+    summary.min = histogram.min();
+    summary.mean = histogram.mean();
+    summary.p50 = histogram.value_at_percentile(50.0);
+    summary.p90 = histogram.value_at_percentile(90.0);
+    summary.p99 = histogram.value_at_percentile(99.0);
+    summary.p999 = histogram.value_at_percentile(99.9);
+    summary.max = histogram.max();
+    return summary;
+}
+
+struct OperationStats {
+    EngineOp operation;
+    DistributionSummary ticks;           // TSC ticks from entry to exit (divide by ticks_per_ns for ns)
+    DistributionSummary fills;           // Trades per call
+    DistributionSummary levels_walked;   // Distinct resting levels traded against per call
+    std::uint64_t allocating_calls = 0;  // Calls that grew the book's order, index or level storage
+};
+
+struct EngineStats {
+    bool enabled = false;          // False unless built with ORDER_BOOK_ENGINE_STATS=1
+    double ticks_per_ns = 0.0;     // TSC frequency, 1.0 where the steady clock stands in for it
+    std::vector<OperationStats> operations;   // Indexed by EngineOp
+};
+
+// Timestamp counter, or steady clock nanoseconds on targets without one
+inline std::uint64_t read_tsc() {
+#if ORDER_BOOK_HAS_TSC
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// read_tsc() ticks per nanosecond, measured once against the steady clock (about 10 ms)
+inline double tsc_ticks_per_ns() {
+#if ORDER_BOOK_HAS_TSC
+    static const double ticks_per_ns = [] {
+        using Clock = std::chrono::steady_clock;
+        auto start_time = Clock::now();
+        std::uint64_t start_ticks = read_tsc();
+        auto end_time = start_time;
+        while (end_time - start_time < std::chrono::milliseconds(10)) {
+            end_time = Clock::now();
+        }
+        std::uint64_t end_ticks = read_tsc();
+        auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
+        return static_cast<double>(end_ticks - start_ticks) / static_cast<double>(nanoseconds);
+    }();
+    return ticks_per_ns;
+#else
+    return 1.0;
+#endif
+}
+
+/**
+ * Instrumentation policy of OrderBook, selected at compile time.
+ *
+ * The book brackets every public entry point with begin()/end() and reports each trade
+ * through on_fill(). NullEngineStats turns all of that into empty inline calls;
+ * EngineStatsRecorder keeps one histogram per operation for the tick count, fills and
+ * levels walked. Only the outermost call is recorded, so the place_limit_order that
+ * modify_order makes internally is part of the MODIFY sample.
+ *
+ * The recorder is not synchronised, and the book's const queries write to it too. With
+ * EngineStatsRecorder a book must not be read from several threads at once.
+ */
+struct NullEngineStats {
+    static constexpr bool ENABLED = false;
+
+    void begin(EngineOp, std::size_t) {}
+    template <typename Footprint>
+    void end(Footprint&&) {}
+    void on_fill(const void*) {}
+
+    EngineStats stats() const { return EngineStats{}; }
+    void reset() {}
+};
+
+class EngineStatsRecorder {
+    private:
+        struct Operation {
+            LatencyHistogram ticks{2};
+            LatencyHistogram fills{1};
+            LatencyHistogram levels_walked{1};
+            std::uint64_t allocating_calls = 0;
+        };
+
+        std::array<Operation, static_cast<std::size_t>(EngineOp::COUNT)> operations;
+
+        // Outermost call in flight
+        int depth = 0;
+        EngineOp current_op = EngineOp::PLACE_LIMIT;
+        std::uint64_t start_ticks = 0;
+        std::size_t start_footprint = 0;
+        std::uint64_t current_fills = 0;
+        std::uint64_t current_levels = 0;
+        const void* last_level = nullptr;
+
+    public:
+        static constexpr bool ENABLED = true;
+
+        // `footprint` is the book's storage size, compared again at end() to spot allocations
+        void begin(EngineOp op, std::size_t footprint) {
+            if (depth++ > 0) {
+                return;
+            }
+            current_op = op;
+            start_footprint = footprint;
+            current_fills = 0;
+            current_levels = 0;
+            last_level = nullptr;
+            start_ticks = read_tsc();
+        }
+
+        template <typename Footprint>
+        void end(Footprint&& footprint) {
+            std::uint64_t end_ticks = read_tsc();
+            if (--depth > 0) {
+                return;
+            }
+            Operation& operation = operations[static_cast<std::size_t>(current_op)];
+            operation.ticks.record(end_ticks - start_ticks);
+            operation.fills.record(current_fills);
+            operation.levels_walked.record(current_levels);
+            if (footprint() != start_footprint) {
+                operation.allocating_calls++;
+            }
+        }
+
+        // One trade against the resting level `level`
+        void on_fill(const void* level) {
+            current_fills++;
+            if (level != last_level) {
+                current_levels++;
+                last_level = level;
+            }
+        }
+
+        EngineStats stats() const {
+            EngineStats stats;
+            stats.enabled = true;
+            stats.ticks_per_ns = tsc_ticks_per_ns();
+            for (std::size_t i = 0; i < operations.size(); ++i) {
+                const Operation& operation = operations[i];
+                stats.operations.push_back(OperationStats{
+                    static_cast<EngineOp>(i),
+                    summarize(operation.ticks),
+                    summarize(operation.fills),
+                    summarize(operation.levels_walked),
+                    operation.allocating_calls
+                });
+            }
+            return stats;
+        }
+
+        void reset() {
+            for (Operation& operation : operations) {
+                operation.ticks.reset();
+                operation.fills.reset();
+                operation.levels_walked.reset();
+                operation.allocating_calls = 0;
+            }
+        }
+};
+
+#if ORDER_BOOK_ENGINE_STATS
+using EngineStatsPolicy = EngineStatsRecorder;
+#else
+using EngineStatsPolicy = NullEngineStats;
+#endif
@@ -0,0 +1,92 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// =========================================================================
+// Event Journal
+// =========================================================================
+
+/**
+ * Append-only journal of fixed-size POD records stored in a chunked arena.
+ *
+ * Records are written into chunks of CHUNK_SIZE entries. A full chunk is never moved or
+ * copied, appending just opens the next chunk, so push_back is a plain store with no
+ * reallocation of earlier records. clear() keeps the chunks for reuse and reserve() can
+ * preallocate them up front, so a warmed-up journal does no heap allocation at all.
+ */
+template <typename T, std::size_t CHUNK_SIZE = 4096>
+class EventJournal {
+    static_assert(std::is_trivially_copyable<T>::value, "EventJournal only stores POD records");
+
+    private:
+        std::vector<std::unique_ptr<T[]>> chunks;
+        std::size_t count = 0;
+
+    public:
+        class const_iterator {
+            private:
+                const EventJournal* journal = nullptr;
+                std::size_t index = 0;
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const T*;
+                using reference = const T&;
+
+                const_iterator() = default;
+                const_iterator(const EventJournal* journal, std::size_t index) : journal(journal), index(index) {}
+
+                reference operator*() const { return (*journal)[index]; }
+                pointer operator->() const { return &(*journal)[index]; }
+                const_iterator& operator++() { ++index; return *this; }
+                const_iterator operator++(int) { const_iterator copy = *this; ++index; return copy; }
+                bool operator==(const const_iterator& other) const { return index == other.index; }
+                bool operator!=(const const_iterator& other) const { return index != other.index; }
+        };
+
+        void push_back(const T& record) {
+            std::size_t slot = count % CHUNK_SIZE;
+            std::size_t chunk = count / CHUNK_SIZE;
+            if (chunk == chunks.size()) {
+                chunks.emplace_back(new T[CHUNK_SIZE]);
+            }
+            chunks[chunk][slot] = record;
+            count++;
+        }
+
+        const T& operator[](std::size_t index) const { return chunks[index / CHUNK_SIZE][index % CHUNK_SIZE]; }
+        const T& back() const { return (*this)[count - 1]; }
+
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, count); }
+
+        // Visit records [first, size()) as contiguous (pointer, length) spans, one per chunk
+        template <typename Fn>
+        void for_each_span(std::size_t first, Fn&& fn) const {
+            while (first < count) {
+                std::size_t slot = first % CHUNK_SIZE;
+                std::size_t length = std::min(CHUNK_SIZE - slot, count - first);
+                fn(&chunks[first / CHUNK_SIZE][slot], length);
+                first += length;
+            }
+        }
+
+        // Preallocate chunks for at least `capacity` records
+        void reserve(std::size_t capacity) {
+            while (chunks.size() * CHUNK_SIZE < capacity) {
+                chunks.emplace_back(new T[CHUNK_SIZE]);
+            }
+        }
+
+        // Forget all records but keep the chunks for reuse
+        void clear() { count = 0; }
+};
@@ -0,0 +1,209 @@
+#pragma once
+#include "types.hpp"
+#include "event_journal.hpp"
+#include "journal_file.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// =========================================================================
+// Event Sinks
+// =========================================================================
+
+/**
+ * Destination for the trade and order events emitted by an OrderBook.
+ *
+ * The book calls on_trade / on_order_event from the matching hot path, so sinks should do
+ * as little as possible there. Sinks that keep records in memory hand them back as
+ * contiguous spans through the *_spans accessors; the others report nothing.
+ *
+ * A sink may throw (BinaryFileSink on I/O errors, Python callbacks). The book only calls a
+ * sink once its own state is consistent again, so the exception aborts the rest of the
+ * incoming order but never leaves an emptied order or a stale level behind.
+ *
+ * Each kind of event is numbered by its position in the sink's stream: the first trade
+ * after construction or clear() has sequence 0, the next 1, and so on. Passing `since`
+ * skips everything older, so a poller that remembers *_sequence() only touches new records.
+ */
+class EventSink {
+    public:
+        template <typename T>
+        using SpanFn = std::function<void(const T*, std::size_t)>;
+
+        virtual ~EventSink() = default;
+
+        virtual void on_trade(const Trade& trade) = 0;
+        virtual void on_order_event(const OrderLog& log) = 0;
+
+        // Sequence the next event of each kind will get (= events seen since the last clear)
+        virtual std::uint64_t trade_sequence() const { return 0; }
+        virtual std::uint64_t order_log_sequence() const { return 0; }
+
+        // Retained records with sequence >= since, oldest first, as contiguous spans
+        virtual void trade_spans(std::uint64_t, const SpanFn<Trade>&) const {}
+        virtual void order_log_spans(std::uint64_t, const SpanFn<OrderLog>&) const {}
+
+        // True if retained records stay at the same address until clear(), so spans may be
+        // handed out as views instead of being copied. clear() may reuse that storage, so such
+        // views are only valid until the next clear()
+        virtual bool has_stable_spans() const { return false; }
+
+        std::vector<Trade> retained_trades(std::uint64_t since = 0) const {
+            return collect_spans<Trade>([&](const SpanFn<Trade>& fn) { trade_spans(since, fn); });
+        }
+        std::vector<OrderLog> retained_order_logs(std::uint64_t since = 0) const {
+            return collect_spans<OrderLog>([&](const SpanFn<OrderLog>& fn) { order_log_spans(since, fn); });
+        }
+
+        virtual void flush() {}
+        virtual void clear() {}
+
+    private:
+        template <typename T, typename Visit>
+        static std::vector<T> collect_spans(Visit&& visit) {
+            std::vector<T> out;
+            visit([&](const T* records, std::size_t count) { out.insert(out.end(), records, records + count); });
+            return out;
+        }
+};
+
+// Drops every event
+class NullSink : public EventSink {
+    public:
+        void on_trade(const Trade&) override {}
+        void on_order_event(const OrderLog&) override {}
+};
+
+// Keeps every event in memory (the default, unbounded)
+class MemorySink : public EventSink {
+    public:
+        EventJournal<OrderLog> order_logs;
+        EventJournal<Trade> trade_logs;
+
+        void on_trade(const Trade& trade) override { trade_logs.push_back(trade); }
+        void on_order_event(const OrderLog& log) override { order_logs.push_back(log); }
+
+        std::uint64_t trade_sequence() const override { return trade_logs.size(); }
+        std::uint64_t order_log_sequence() const override { return order_logs.size(); }
+
+        void trade_spans(std::uint64_t since, const SpanFn<Trade>& fn) const override {
+            trade_logs.for_each_span(since, fn);
+        }
+        void order_log_spans(std::uint64_t since, const SpanFn<OrderLog>& fn) const override {
+            order_logs.for_each_span(since, fn);
+        }
+
+        // Journal chunks never move
+        bool has_stable_spans() const override { return true; }
+
+        void clear() override {
+            order_logs.clear();
+            trade_logs.clear();
+        }
+};
+
+// Keeps only the most recent N events of each kind in preallocated rings
+class RingSink : public EventSink {
+    private:
+        template <typename T>
+        struct Ring {
+            std::vector<T> records;
+            std::size_t next = 0;
+            std::size_t count = 0;
+            std::uint64_t total = 0;
+
+            explicit Ring(std::size_t capacity) : records(capacity == 0 ? 1 : capacity) {}
+
+            void push(const T& record) {
+                records[next] = record;
+                next = (next + 1) % records.size();
+                if (count < records.size()) {
+                    count++;
+                }
+                total++;
+            }
+
+            // At most two spans: the tail of the array, then its head after wrapping
+            void spans(std::uint64_t since, const SpanFn<T>& fn) const {
+                std::uint64_t oldest = total - count;
+                std::size_t skip = since > oldest ? static_cast<std::size_t>(std::min<std::uint64_t>(since - oldest, count)) : 0;
+                std::size_t remaining = count - skip;
+                std::size_t start = (next + records.size() - remaining) % records.size();
+                while (remaining > 0) {
+                    std::size_t length = std::min(remaining, records.size() - start);
+                    fn(&records[start], length);
+                    remaining -= length;
+                    start = 0;
+                }
+            }
+
+            void clear() { next = count = total = 0; }
+        };
+
+        Ring<Trade> trades;
+        Ring<OrderLog> order_logs;
+
+    public:
+        RingSink(std::size_t trade_capacity, std::size_t order_log_capacity)
+            : trades(trade_capacity), order_logs(order_log_capacity) {}
+
+        void on_trade(const Trade& trade) override { trades.push(trade); }
+        void on_order_event(const OrderLog& log) override { order_logs.push(log); }
+
+        std::uint64_t trade_sequence() const override { return trades.total; }
+        std::uint64_t order_log_sequence() const override { return order_logs.total; }
+
+        // Records older than the ring capacity are gone; the spans start at the oldest kept
+        void trade_spans(std::uint64_t since, const SpanFn<Trade>& fn) const override { trades.spans(since, fn); }
+        void order_log_spans(std::uint64_t since, const SpanFn<OrderLog>& fn) const override { order_logs.spans(since, fn); }
+
+        void clear() override {
+            trades.clear();
+            order_logs.clear();
+        }
+};
+
+// Streams events into two versioned journal files (see journal_file.hpp), one for trades
+// and one for order events, sharing one sequence number so they can be merged back in order
+class BinaryFileSink : public EventSink {
+    private:
+        JournalWriter<TradeRecord> trade_journal;
+        JournalWriter<OrderLogRecord> order_journal;
+        std::uint64_t next_sequence = 1;
+
+    public:
+        BinaryFileSink(const std::string& trade_path, const std::string& order_path)
+            : trade_journal(trade_path), order_journal(order_path) {}
+
+        void on_trade(const Trade& trade) override { trade_journal.append(TradeRecord{next_sequence++, trade}); }
+        void on_order_event(const OrderLog& log) override { order_journal.append(OrderLogRecord{next_sequence++, log}); }
+
+        void flush() override {
+            trade_journal.flush();
+            order_journal.flush();
+        }
+};
+
+// Forwards every event to user callbacks (either may be empty)
+class CallbackSink : public EventSink {
+    public:
+        std::function<void(const Trade&)> trade_callback;
+        std::function<void(const OrderLog&)> order_event_callback;
+
+        CallbackSink() = default;
+        CallbackSink(std::function<void(const Trade&)> on_trade_fn,
+                     std::function<void(const OrderLog&)> on_order_event_fn)
+            : trade_callback(std::move(on_trade_fn)), order_event_callback(std::move(on_order_event_fn)) {}
+
+        void on_trade(const Trade& trade) override {
+            if (trade_callback) trade_callback(trade);
+        }
+        void on_order_event(const OrderLog& log) override {
+            if (order_event_callback) order_event_callback(log);
+        }
+};
@@ -0,0 +1,165 @@
+#pragma once
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// =========================================================================
+// Binary Journal File Format
+// =========================================================================
+//
+// A journal file is a 64-byte JournalFileHeader followed by fixed-size records of a
+// single type. Every record starts with a sequence number shared by all journals of one
+// writer, so trade and order journals can be merged back into event order. The record
+// count is not stored; it follows from the file size, which also makes a journal readable
+// while it is still being written or after a crash (a torn last record is ignored).
+//
+// Records are the in-memory POD structs, so the format is native-endian and tied to the
+// struct layout; bump JOURNAL_VERSION whenever Trade or OrderLog change.
+
+constexpr char JOURNAL_MAGIC[8] = {'O', 'B', 'J', 'O', 'U', 'R', 'N', 'L'};
+constexpr std::uint32_t JOURNAL_VERSION = 1;
+
+enum class JournalRecordType : std::uint32_t {
+    TRADE = 1,
+    ORDER_LOG = 2
+};
+
+struct JournalFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t record_type;   // JournalRecordType
+    std::uint32_t header_size;   // Offset of the first record
+    std::uint32_t record_size;   // sizeof one record
+    std::uint64_t reserved[5];
+};
+static_assert(sizeof(JournalFileHeader) == 64, "JournalFileHeader must be 64 bytes");
+
+struct TradeRecord {
+    static constexpr JournalRecordType TYPE = JournalRecordType::TRADE;
+    std::uint64_t sequence;
+    Trade trade;
+};
+
+struct OrderLogRecord {
+    static constexpr JournalRecordType TYPE = JournalRecordType::ORDER_LOG;
+    std::uint64_t sequence;
+    OrderLog log;
+};
+
+// Appends records of one type to a journal file, writing the header on open
+template <typename Record>
+class JournalWriter {
+    static_assert(std::is_trivially_copyable<Record>::value, "Journal records must be POD");
+
+    private:
+        std::FILE* file = nullptr;
+        std::string path;
+
+        // A short write (full disk, I/O error) must not leave a silently truncated journal
+        void write(const void* data, std::size_t size) {
+            if (std::fwrite(data, size, 1, file) != 1) {
+                throw std::runtime_error("Cannot write journal file: " + path);
+            }
+        }
+
+    public:
+        explicit JournalWriter(const std::string& path) : path(path) {
+            file = std::fopen(path.c_str(), "wb");
+            if (file == nullptr) {
+                throw std::runtime_error("Cannot open journal file: " + path);
+            }
+            std::setvbuf(file, nullptr, _IOFBF, 1 << 16);
+
+            JournalFileHeader header{};
+            std::memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+            header.version = JOURNAL_VERSION;
+            header.record_type = static_cast<std::uint32_t>(Record::TYPE);
+            header.header_size = sizeof(JournalFileHeader);
+            header.record_size = sizeof(Record);
+            if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+                std::fclose(file);
+                throw std::runtime_error("Cannot write journal file: " + path);
+            }
+        }
+
+        ~JournalWriter() { std::fclose(file); }
+
+        JournalWriter(const JournalWriter&) = delete;
+        JournalWriter& operator=(const JournalWriter&) = delete;
+
+        void append(const Record& record) { write(&record, sizeof(Record)); }
+        void flush() {
+            if (std::fflush(file) != 0) {
+                throw std::runtime_error("Cannot write journal file: " + path);
+            }
+        }
+};
+
+// Read-only memory mapping of a whole file (POSIX mmap / Win32 file mapping)
+class MappedFile {
+    private:
+        const unsigned char* bytes = nullptr;
+        std::size_t length = 0;
+#if defined(_WIN32)
+        void* file_handle = nullptr;
+        void* mapping_handle = nullptr;
+#endif
+
+    public:
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const unsigned char* data() const { return bytes; }
+        std::size_t size() const { return length; }
+};
+
+// Zero-copy view over a journal file, validated against the expected record type
+template <typename Record>
+class JournalReader {
+    private:
+        MappedFile file;
+        const Record* records = nullptr;
+        std::size_t count = 0;
+
+    public:
+        explicit JournalReader(const std::string& path) : file(path) {
+            if (file.size() < sizeof(JournalFileHeader)) {
+                throw std::runtime_error("Not a journal file (too short): " + path);
+            }
+            const JournalFileHeader& header = *reinterpret_cast<const JournalFileHeader*>(file.data());
+            if (std::memcmp(header.magic, JOURNAL_MAGIC, sizeof(header.magic)) != 0) {
+                throw std::runtime_error("Not a journal file (bad magic): " + path);
+            }
+            if (header.version != JOURNAL_VERSION) {
+                throw std::runtime_error("Unsupported journal version " + std::to_string(header.version) + ": " + path);
+            }
+            if (header.record_type != static_cast<std::uint32_t>(Record::TYPE) || header.record_size != sizeof(Record)) {
+                throw std::runtime_error("Journal holds a different record type: " + path);
+            }
+            // Trust header_size only once it points between the header and the end of the file,
+            // at an offset records can be read from
+            if (header.header_size < sizeof(JournalFileHeader) || header.header_size > file.size()
+                || header.header_size % alignof(Record) != 0) {
+                throw std::runtime_error("Corrupt journal header (bad header size): " + path);
+            }
+            records = reinterpret_cast<const Record*>(file.data() + header.header_size);
+            count = (file.size() - header.header_size) / sizeof(Record);
+        }
+
+        const JournalFileHeader& header() const { return *reinterpret_cast<const JournalFileHeader*>(file.data()); }
+
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        const Record& operator[](std::size_t index) const { return records[index]; }
+        const Record* data() const { return records; }
+        const Record* begin() const { return records; }
+        const Record* end() const { return records + count; }
+};
@@ -0,0 +1,143 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// =========================================================================
+// Latency Histogram
+// =========================================================================
+
+/**
+ * HDR-style histogram of non-negative integer values (nanoseconds, cycles, ...).
+ *
+ * Values below `sub_bucket_count` are counted exactly. Above that, every power of two
+ * [2^k, 2^(k+1)) is split into sub_bucket_count / 2 linear buckets, so every recorded value is
+ * known to within 10^-significant_digits of itself over the whole 64-bit range. Recording is
+ * a bit scan, a shift and an increment. Memory is fixed at construction (about 450 KB for 3
+ * digits) and never grows.
+ *
+ * Percentiles report the highest value equivalent to the bucket they fall in (as HdrHistogram
+ * does), capped at the largest value actually recorded.
+ */
+class LatencyHistogram {
+    private:
+        int significant_digits;
+        int sub_bucket_bits;            // log2(sub_bucket_count)
+        std::uint64_t sub_bucket_count;
+        std::uint64_t sub_bucket_half;
+        std::vector<std::uint64_t> counts;
+
+        std::uint64_t total = 0;
+        std::uint64_t min_value = std::numeric_limits<std::uint64_t>::max();
+        std::uint64_t max_value = 0;
+        double sum = 0.0;
+
+        static int highest_bit(std::uint64_t value) {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanReverse64(&index, value);
+            return static_cast<int>(index);
+#else
+            return 63 - __builtin_clzll(value);
+#endif
+        }
+
+        std::size_t index_of(std::uint64_t value) const {
+            if (value < sub_bucket_count) {
+                return static_cast<std::size_t>(value);
+            }
+            int shift = highest_bit(value) - (sub_bucket_bits - 1);
+            std::uint64_t sub_bucket = value >> shift;   // In [half, count)
+            return static_cast<std::size_t>(static_cast<std::uint64_t>(shift + 1) * sub_bucket_half + (sub_bucket - sub_bucket_half));
+        }
+
+        // Largest value that lands in the same bucket as index
+        std::uint64_t highest_equivalent(std::size_t index) const {
+            if (index < sub_bucket_count) {
+                return static_cast<std::uint64_t>(index);
+            }
+            std::uint64_t shift = index / sub_bucket_half - 1;
+            std::uint64_t sub_bucket = index % sub_bucket_half + sub_bucket_half;
+            std::uint64_t lowest = sub_bucket << shift;
+            return lowest + ((std::uint64_t{1} << shift) - 1);
+        }
+
+    public:
+        explicit LatencyHistogram(int significant_digits = 3) : significant_digits(significant_digits) {
+            if (significant_digits < 1 || significant_digits > 5) {
+                throw std::runtime_error("LatencyHistogram supports 1 to 5 significant digits");
+            }
+            // 2 * 10^digits linear sub-buckets keep the relative bucket width below 10^-digits
+            std::uint64_t needed = 2;
+            for (int i = 0; i < significant_digits; ++i) {
+                needed *= 10;
+            }
+            sub_bucket_bits = 1;
+            while ((std::uint64_t{1} << sub_bucket_bits) < needed) {
+                ++sub_bucket_bits;
+            }
+            sub_bucket_count = std::uint64_t{1} << sub_bucket_bits;
+            sub_bucket_half = sub_bucket_count / 2;
+            counts.assign(static_cast<std::size_t>((64 - sub_bucket_bits + 1) * sub_bucket_half + sub_bucket_half), 0);
+        }
+
+        void record(std::uint64_t value) {
+            counts[index_of(value)]++;
+            total++;
+            min_value = std::min(min_value, value);
+            max_value = std::max(max_value, value);
+            sum += static_cast<double>(value);
+        }
+
+        // Add another histogram of the same precision
+        void merge(const LatencyHistogram& other) {
+            if (other.significant_digits != significant_digits) {
+                throw std::runtime_error("Cannot merge histograms of different precision");
+            }
+            for (std::size_t i = 0; i < counts.size(); ++i) {
+                counts[i] += other.counts[i];
+            }
+            total += other.total;
+            min_value = std::min(min_value, other.min_value);
+            max_value = std::max(max_value, other.max_value);
+            sum += other.sum;
+        }
+
+        void reset() {
+            std::fill(counts.begin(), counts.end(), 0);
+            total = 0;
+            min_value = std::numeric_limits<std::uint64_t>::max();
+            max_value = 0;
+            sum = 0.0;
+        }
+
+        std::uint64_t count() const { return total; }
+        std::uint64_t min() const { return total == 0 ? 0 : min_value; }
+        std::uint64_t max() const { return max_value; }
+        double mean() const { return total == 0 ? 0.0 : sum / static_cast<double>(total); }
+
+        // Smallest bucket value with at least `percentile` % of the recorded values at or below it
+        std::uint64_t value_at_percentile(double percentile) const {
+            if (total == 0) {
+                return 0;
+            }
+            percentile = std::min(std::max(percentile, 0.0), 100.0);
+            auto rank = static_cast<std::uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(total)));
+            rank = std::max<std::uint64_t>(rank, 1);
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < counts.size(); ++i) {
+                seen += counts[i];
+                if (seen >= rank) {
+                    return std::min(highest_equivalent(i), max_value);
+                }
+            }
+            return max_value;
+        }
+};
@@ -0,0 +1,73 @@
+#pragma once
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// =========================================================================
+// Level 2 Delta Log
+// =========================================================================
+
+/**
+ * Bounded history of price level changes, the source of incremental Level 2 feeds.
+ *
+ * The book records the new aggregates of every level it touches (added to, filled, reduced,
+ * emptied). Each change gets the next sequence number and lands in a power-of-two ring, so
+ * the log never allocates after enable() and a reader catches up in O(changes) instead of
+ * copying the whole depth. Once a change has been overwritten, readers further behind than
+ * that have to resynchronise from a full snapshot.
+ *
+ * Disabled (capacity 0) by default, recording is then a single branch.
+ */
+class LevelUpdateLog {
+    private:
+        std::vector<LevelUpdate> ring;
+        std::size_t mask = 0;
+        std::uint64_t next_sequence = 1;
+        std::uint64_t first_valid = 1;  // Oldest sequence still readable
+
+    public:
+        // Capacity is rounded up to a power of two, 0 disables the log
+        void enable(std::size_t capacity) {
+            std::size_t size = 0;
+            if (capacity > 0) {
+                size = 1;
+                while (size < capacity) {
+                    size <<= 1;
+                }
+            }
+            ring.assign(size, LevelUpdate{});
+            mask = size == 0 ? 0 : size - 1;
+            invalidate();
+        }
+
+        bool enabled() const { return !ring.empty(); }
+        std::size_t capacity() const { return ring.size(); }
+
+        void record(OrderSide side, Price price, Quantity total_quantity, std::uint32_t order_count, Timestamp timestamp) {
+            std::uint64_t sequence = next_sequence++;
+            ring[sequence & mask] = LevelUpdate{sequence, timestamp, price, total_quantity, order_count, side};
+            if (next_sequence - first_valid > ring.size()) {
+                first_valid = next_sequence - ring.size();
+            }
+        }
+
+        // Sequence of the latest change, 0 before the first one
+        std::uint64_t last_sequence() const { return next_sequence - 1; }
+
+        // Changes after `since`, oldest first; false if some of them are no longer in the ring
+        bool copy_since(std::uint64_t since, std::vector<LevelUpdate>& out) const {
+            if (since + 1 < first_valid || since > last_sequence()) {
+                return false;
+            }
+            out.reserve(out.size() + (next_sequence - since - 1));
+            for (std::uint64_t sequence = since + 1; sequence < next_sequence; ++sequence) {
+                out.push_back(ring[sequence & mask]);
+            }
+            return true;
+        }
+
+        // Forget the history (book cleared), every reader has to resynchronise. Skipping a
+        // sequence number makes readers that were fully caught up resynchronise as well.
+        void invalidate() { first_valid = ++next_sequence; }
+};
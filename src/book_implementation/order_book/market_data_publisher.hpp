@@ -0,0 +1,134 @@
+#pragma once
+#include "order_book.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// =========================================================================
+// Lock-free Market Data Publication
+// =========================================================================
+
+/**
+ * Single-writer sequence lock around a POD value.
+ *
+ * The writer bumps the sequence to odd, stores the value, and bumps it back to even; a reader
+ * copies the value between two reads of the sequence and retries if they differ or are odd.
+ * Readers never block the writer and need no lock, any number of them can poll at once.
+ * The value is kept as relaxed atomic words, so concurrent copies are well defined.
+ */
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock only protects POD values");
+
+    private:
+        static constexpr std::size_t WORDS = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+        std::atomic<std::uint64_t> sequence{0};
+        std::atomic<std::uint64_t> words[WORDS] = {};
+
+    public:
+        // Writer thread only
+        void store(const T& value) {
+            std::uint64_t buffer[WORDS] = {};
+            std::memcpy(buffer, &value, sizeof(T));
+
+            std::uint64_t seq = sequence.load(std::memory_order_relaxed);
+            sequence.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (std::size_t i = 0; i < WORDS; ++i) {
+                words[i].store(buffer[i], std::memory_order_relaxed);
+            }
+            sequence.store(seq + 2, std::memory_order_release);
+        }
+
+        // Any thread; spins only while a store is in progress
+        T load() const {
+            std::uint64_t buffer[WORDS];
+            while (true) {
+                std::uint64_t before = sequence.load(std::memory_order_acquire);
+                if (before & 1) {
+                    continue;
+                }
+                for (std::size_t i = 0; i < WORDS; ++i) {
+                    buffer[i] = words[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence.load(std::memory_order_relaxed) == before) {
+                    break;
+                }
+            }
+            T value;
+            std::memcpy(&value, buffer, sizeof(T));
+            return value;
+        }
+
+        // Number of completed stores
+        std::uint64_t version() const { return sequence.load(std::memory_order_acquire) / 2; }
+};
+
+/**
+ * Two seqlocked buffers: the writer always fills the one readers are not pointed at, then
+ * flips the pointer. A reader only has to retry when the pointer flips during its copy,
+ * which keeps large snapshots (depth-N books) readable under a fast writer.
+ */
+template <typename T>
+class DoubleBuffered {
+    private:
+        SeqLock<T> buffers[2];
+        std::atomic<std::uint32_t> front{0};
+
+    public:
+        // Writer thread only
+        void store(const T& value) {
+            std::uint32_t back = front.load(std::memory_order_relaxed) ^ 1u;
+            buffers[back].store(value);
+            front.store(back, std::memory_order_release);
+        }
+
+        // Any thread; a copy taken from a buffer that stopped being the front while it was read
+        // is retried, so successive loads never go back to an older publication
+        T load() const {
+            while (true) {
+                std::uint32_t index = front.load(std::memory_order_acquire);
+                T value = buffers[index].load();
+                if (front.load(std::memory_order_acquire) == index) {
+                    return value;
+                }
+            }
+        }
+};
+
+constexpr std::size_t PUBLISHED_DEPTH = 10;
+
+// Fixed-size top-N book published next to the top of book
+struct DepthSnapshot {
+    std::uint64_t version;       // Publication number, increases with every publish()
+    DepthN<PUBLISHED_DEPTH> depth;
+};
+static_assert(std::is_trivially_copyable<DepthSnapshot>::value, "DepthSnapshot must stay a POD record");
+
+// Latest consistent market data of one book, written by the matching thread, read by anyone
+class MarketDataPublisher {
+    private:
+        SeqLock<Level1Data> level1;
+        DoubleBuffered<DepthSnapshot> depth;
+        std::uint64_t published = 0;   // Writer-side count
+
+    public:
+        // Matching thread: snapshot the book after an event batch
+        void publish(const OrderBook& book) {
+            level1.store(book.get_level1_data());
+
+            DepthSnapshot snapshot{};
+            snapshot.version = ++published;
+            book.fill_depth(snapshot.depth);
+            depth.store(snapshot);
+        }
+
+        // Reader threads, never block the matching thread
+        Level1Data read_level1() const { return level1.load(); }
+        DepthSnapshot read_depth() const { return depth.load(); }
+        std::uint64_t version() const { return level1.version(); }
+};
@@ -0,0 +1,151 @@
+#include "matching_engine.hpp"
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// =========================================================================
+// Egress sink
+// =========================================================================
+
+void MatchingEngine::EgressSink::publish(const EngineEvent& event) {
+    std::uint32_t stalled = 0;
+    while (!engine.events.try_push(event)) {
+        // Once stopping, a ring that stays full means nobody drains any more: don't hang the
+        // shutdown, drop the rest
+        if (engine.stop_requested.load(std::memory_order_acquire) &&
+            (consumer_gone || ++stalled > STALL_LIMIT)) {
+            consumer_gone = true;
+            engine.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        std::this_thread::yield();
+    }
+}
+
+void MatchingEngine::EgressSink::on_trade(const Trade& trade) {
+    EngineEvent event;
+    event.type = EngineEventType::TRADE;
+    event.trade = trade;
+    publish(event);
+}
+
+void MatchingEngine::EgressSink::on_order_event(const OrderLog& log) {
+    EngineEvent event;
+    event.type = EngineEventType::ORDER_LOG;
+    event.log = log;
+    publish(event);
+}
+
+// =========================================================================
+// Engine
+// =========================================================================
+
+MatchingEngine::MatchingEngine(const EngineConfig& config, const std::optional<LadderConfig>& ladder)
+    : config(config),
+      commands(config.command_capacity),
+      events(config.event_capacity),
+      egress_sink(std::make_shared<EgressSink>(*this)),
+      order_book(ladder ? OrderBook(*ladder, egress_sink) : OrderBook(egress_sink)) {}
+
+MatchingEngine::~MatchingEngine() {
+    try {
+        stop();
+    } catch (...) {
+        // A destructor can't report the matching error, call stop() first to see it
+    }
+}
+
+void MatchingEngine::start() {
+    if (running.load(std::memory_order_acquire)) {
+        return;
+    }
+    stop_requested.store(false, std::memory_order_release);
+    failed.store(false, std::memory_order_release);
+    egress_sink->consumer_gone = false;
+    market_data.publish(order_book);
+    running.store(true, std::memory_order_release);
+    matching_thread = std::thread(&MatchingEngine::matching_loop, this);
+
+#if defined(__linux__)
+    if (config.cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(config.cpu, &cpus);
+        pthread_setaffinity_np(matching_thread.native_handle(), sizeof(cpus), &cpus);
+    }
+#endif
+}
+
+void MatchingEngine::stop() {
+    if (!running.load(std::memory_order_acquire)) {
+        return;
+    }
+    stop_requested.store(true, std::memory_order_release);
+    matching_thread.join();
+    running.store(false, std::memory_order_release);
+    if (error) {
+        std::exception_ptr rethrow = error;
+        error = nullptr;
+        std::rethrow_exception(rethrow);
+    }
+}
+
+void MatchingEngine::submit(const OrderCommand& command) {
+    while (true) {
+        // Nobody drains the ring any more, don't queue into it or spin forever
+        if (has_failed()) {
+            throw std::runtime_error("Matching thread stopped after an error, call stop() to see it");
+        }
+        if (commands.try_push(command)) {
+            return;
+        }
+        // Before start() or after stop() a full ring would never free up
+        if (!is_running()) {
+            throw std::runtime_error("Command ring is full and the matching engine is not running");
+        }
+        std::this_thread::yield();
+    }
+}
+
+OrderBook& MatchingEngine::get_order_book() {
+    if (running.load(std::memory_order_acquire)) {
+        throw std::runtime_error("Order book is owned by the matching thread while the engine runs");
+    }
+    return order_book;
+}
+
+void MatchingEngine::matching_loop() {
+    OrderCommand command;
+    std::uint32_t idle_spins = 0;
+    while (true) {
+        std::size_t batch = 0;
+        try {
+            while (batch < config.batch_size && commands.try_pop(command)) {
+                apply_command(order_book, command);
+                batch++;
+            }
+        } catch (...) {
+            error = std::current_exception();
+            failed.store(true, std::memory_order_release);
+            return;
+        }
+        if (batch > 0) {
+            market_data.publish(order_book);
+            processed.fetch_add(batch, std::memory_order_relaxed);
+            idle_spins = 0;
+            continue;
+        }
+
+        // Everything submitted before stop() has been matched
+        if (stop_requested.load(std::memory_order_acquire) && commands.empty()) {
+            return;
+        }
+        // Spin briefly for the next burst, then give the core away
+        if (++idle_spins > 1024) {
+            std::this_thread::yield();
+        }
+    }
+}
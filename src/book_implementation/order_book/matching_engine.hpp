@@ -0,0 +1,121 @@
+#pragma once
+#include "order_book.hpp"
+#include "order_command.hpp"
+#include "spsc_ring.hpp"
+#include "market_data_publisher.hpp"
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <thread>
+
+// =========================================================================
+// Threaded Matching Engine
+// =========================================================================
+
+enum class EngineEventType : std::uint8_t {
+    TRADE,
+    ORDER_LOG
+};
+
+// One trade or order event, copied through the egress ring
+struct EngineEvent {
+    EngineEventType type;
+    union {
+        Trade trade;
+        OrderLog log;
+    };
+};
+static_assert(std::is_trivially_copyable<EngineEvent>::value, "EngineEvent must stay a POD record");
+
+struct EngineConfig {
+    std::size_t command_capacity = 1 << 16;
+    std::size_t event_capacity = 1 << 18;
+    std::size_t batch_size = 256;   // Commands matched before the engine looks up again
+    int cpu = -1;                   // Core to pin the matching thread to (Linux), -1 = no pinning
+};
+
+/**
+ * OrderBook driven by its own matching thread.
+ *
+ * A feed thread pushes OrderCommands into an SPSC ingress ring; the matching thread drains
+ * it in batches and applies each command to the book; every trade and order event the book
+ * emits goes out on an SPSC egress ring to one consumer thread. Neither side ever takes a
+ * lock, so a burst on the feed only costs ring slots, not latency on the matching thread.
+ * After every batch the matching thread also publishes the top of book and a depth-N
+ * snapshot (see MarketDataPublisher), which any thread may read while matching runs.
+ *
+ * Exactly one thread may submit and exactly one thread may poll. When the egress ring is
+ * full the matching thread waits for the consumer (backpressure); only during stop(), once
+ * the ring stops draining, are the remaining events dropped and counted. The book itself may only be touched
+ * through get_order_book() while the engine is stopped.
+ */
+class MatchingEngine {
+    private:
+        // Book event sink feeding the egress ring
+        class EgressSink : public EventSink {
+            private:
+                static constexpr std::uint32_t STALL_LIMIT = 100000;   // Yields without room during stop()
+                MatchingEngine& engine;
+                void publish(const EngineEvent& event);
+
+            public:
+                bool consumer_gone = false;
+
+                explicit EgressSink(MatchingEngine& engine) : engine(engine) {}
+                void on_trade(const Trade& trade) override;
+                void on_order_event(const OrderLog& log) override;
+        };
+
+        EngineConfig config;
+        SpscRing<OrderCommand> commands;
+        SpscRing<EngineEvent> events;
+        std::shared_ptr<EgressSink> egress_sink;
+        OrderBook order_book;
+        MarketDataPublisher market_data;
+
+        std::thread matching_thread;
+        std::atomic<bool> running{false};
+        std::atomic<bool> stop_requested{false};
+        std::atomic<std::uint64_t> processed{0};
+        std::atomic<std::uint64_t> dropped{0};
+        std::exception_ptr error;   // First exception of the matching thread, rethrown by stop()
+        std::atomic<bool> failed{false};   // Set once the matching thread has exited on `error`
+
+        void matching_loop();
+
+    public:
+        explicit MatchingEngine(const EngineConfig& config = EngineConfig{},
+                                const std::optional<LadderConfig>& ladder = std::nullopt);
+        ~MatchingEngine();
+
+        MatchingEngine(const MatchingEngine&) = delete;
+        MatchingEngine& operator=(const MatchingEngine&) = delete;
+
+        // Start the matching thread; stop() matches everything already submitted, then joins
+        // and rethrows if a command made the book throw (the thread stops at that command)
+        void start();
+        void stop();
+        bool is_running() const { return running.load(std::memory_order_acquire); }
+        // True once a command made the book throw; nothing is matched until stop() and start()
+        bool has_failed() const { return failed.load(std::memory_order_acquire); }
+
+        // Producer thread: false if the ingress ring is full or the matching thread has failed /
+        // waits for room, throws once the matching thread has failed or if the ring is full
+        // while the engine is not running (commands may be queued before start())
+        bool try_submit(const OrderCommand& command) { return !has_failed() && commands.try_push(command); }
+        void submit(const OrderCommand& command);
+
+        // Consumer thread: next trade / order event, false if none is waiting
+        bool poll_event(EngineEvent& event) { return events.try_pop(event); }
+
+        // Any thread, lock-free: latest published market data
+        const MarketDataPublisher& get_market_data() const { return market_data; }
+
+        std::uint64_t get_processed_commands() const { return processed.load(std::memory_order_relaxed); }
+        std::uint64_t get_dropped_events() const { return dropped.load(std::memory_order_relaxed); }
+
+        // Only while stopped
+        OrderBook& get_order_book();
+};
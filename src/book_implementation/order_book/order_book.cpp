@@ -4,419 +4,492 @@
 #include <vector>
 #include <algorithm>
 
+namespace {
+
+// Compile-time side policy of the matching core, keyed by the aggressor's side
+template <OrderSide Side>
+struct SideTraits;
+
+template <>
+struct SideTraits<OrderSide::BUY> {
+    static constexpr OrderSide OPPOSITE = OrderSide::SELL;
+
+    // A buy limit reaches every ask at or below its price
+    static bool crosses(Price limit_price, Price resting_price) { return !(limit_price < resting_price); }
+
+    static Trade trade(TradeID trade_id, const Order& aggressor, const Order& resting, Price price, Quantity quantity) {
+        return Trade{trade_id, aggressor.order_id, resting.order_id, OrderSide::BUY,
+                     aggressor.trader_id, resting.trader_id, price, quantity, 0};
+    }
+};
+
+template <>
+struct SideTraits<OrderSide::SELL> {
+    static constexpr OrderSide OPPOSITE = OrderSide::BUY;
+
+    // A sell limit reaches every bid at or above its price
+    static bool crosses(Price limit_price, Price resting_price) { return !(limit_price > resting_price); }
+
+    static Trade trade(TradeID trade_id, const Order& aggressor, const Order& resting, Price price, Quantity quantity) {
+        return Trade{trade_id, resting.order_id, aggressor.order_id, OrderSide::SELL,
+                     resting.trader_id, aggressor.trader_id, price, quantity, 0};
+    }
+};
+
+}  // namespace
+
 Price OrderBook::get_best_bid() const {
-    if (buy_orders.empty()) {
+    const LevelQueue* level = best_level(OrderSide::BUY);
+    if (level == nullptr) {
         return 0.0;
     }
-    return buy_orders.begin()->first;
+    return level->price;
 }
 
 Price OrderBook::get_best_ask() const {
-    if (sell_orders.empty()) {
+    const LevelQueue* level = best_level(OrderSide::SELL);
+    if (level == nullptr) {
         return 0.0;
     }
-    return sell_orders.begin()->first;
+    return level->price;
+}
+
+template <OrderSide Side>
+const LevelQueue* OrderBook::best_level() const {
+    if (ladder_of<Side>()) {
+        return ladder_of<Side>()->best_level();
+    }
+    const auto& levels = levels_of<Side>();
+    return levels.empty() ? nullptr : &levels.begin()->second;
+}
+
+const LevelQueue* OrderBook::best_level(OrderSide side) const {
+    return side == OrderSide::BUY ? best_level<OrderSide::BUY>() : best_level<OrderSide::SELL>();
+}
+
+const LevelQueue* OrderBook::find_level(OrderSide side, Price price) const {
+    if (side == OrderSide::BUY) {
+        if (bid_ladder) {
+            return bid_ladder->find(price);
+        }
+        auto it = buy_orders.find(price);
+        return it == buy_orders.end() ? nullptr : &it->second;
+    }
+    if (ask_ladder) {
+        return ask_ladder->find(price);
+    }
+    auto it = sell_orders.find(price);
+    return it == sell_orders.end() ? nullptr : &it->second;
+}
+
+bool OrderBook::snap_to_ladder(Order& order) const {
+    if (!bid_ladder) {
+        return true;
+    }
+    const PriceLadder& ladder = (order.side == OrderSide::BUY) ? *bid_ladder : *ask_ladder;
+    Tick tick = ladder.snap_tick(order.price);
+    if (tick == PriceLadder::NO_TICK) {
+        return false;
+    }
+    order.price = ladder.to_price(tick);
+    return true;
+}
+
+namespace {
+
+// Slabs held by a level map's node pool, nothing to report for other allocators
+template <typename T>
+std::size_t pool_slabs(const SlabAllocator<T>& allocator) {
+    return allocator.get_arena().slab_count();
+}
+
+template <typename Allocator>
+std::size_t pool_slabs(const Allocator&) {
+    return 0;
+}
+
+}  // namespace
+
+std::size_t OrderBook::storage_footprint() const {
+    return order_store.capacity() + order_index.capacity() +
+           pool_slabs(buy_orders.get_allocator()) + pool_slabs(sell_orders.get_allocator());
+}
+
+void OrderBook::reserve(std::size_t orders, std::size_t levels) {
+    order_store.reserve(orders);
+    order_index.reserve(orders);
+    if (bid_ladder) {
+        return;  // Ladder levels are allocated up front
+    }
+    // Cycle `levels` nodes per side through the map so the pools hold them on the free list
+    if (buy_orders.size() < levels) {
+        LevelMap<std::greater<Price>> warm(buy_orders.get_allocator());
+        for (std::size_t i = 0; i < levels; ++i) {
+            warm.emplace(static_cast<Price>(i), LevelQueue{});
+        }
+    }
+    if (sell_orders.size() < levels) {
+        LevelMap<std::less<Price>> warm(sell_orders.get_allocator());
+        for (std::size_t i = 0; i < levels; ++i) {
+            warm.emplace(static_cast<Price>(i), LevelQueue{});
+        }
+    }
+}
+
+template <OrderSide Side>
+void OrderBook::rest_order(const Order& order) {
+    NodeHandle handle = order_store.allocate(order);
+    if (ladder_of<Side>()) {
+        PriceLadder& ladder = *ladder_of<Side>();
+        Tick tick = ladder.find_tick(order.price);
+        LevelQueue& level = ladder.level_at(tick);
+        bool was_empty = level.empty();
+        order_store.push_back(level, handle);
+        if (was_empty) {
+            ladder.mark_occupied(tick);
+        }
+        record_level_change(Side, level);
+    } else {
+        LevelQueue& level = levels_of<Side>()[order.price];
+        level.price = order.price;
+        order_store.push_back(level, handle);
+        record_level_change(Side, level);
+    }
+    order_index.insert(order.order_id, handle);
+}
+
+template <OrderSide Side>
+void OrderBook::remove_order(NodeHandle handle) {
+    OrderNode& node = order_store[handle];
+    LevelQueue& level = *node.level;
+    order_store.unlink(handle);
+    order_index.erase(node.order.order_id);
+    record_level_change(Side, level);
+    if (level.empty()) {
+        if (ladder_of<Side>()) {
+            PriceLadder& ladder = *ladder_of<Side>();
+            ladder.mark_empty(ladder.tick_of(level));
+        } else {
+            levels_of<Side>().erase(level.price);
+        }
+    }
+    order_store.release(handle);
+}
+
+void OrderBook::remove_order(NodeHandle handle) {
+    if (order_store[handle].order.side == OrderSide::BUY) {
+        remove_order<OrderSide::BUY>(handle);
+    } else {
+        remove_order<OrderSide::SELL>(handle);
+    }
+}
+
+void OrderBook::check_invariants_after_event() {
+    switch (invariant_mode) {
+        case InvariantMode::OFF:
+            return;
+        case InvariantMode::CHEAP:
+            check_no_crossing();
+            return;
+        case InvariantMode::SAMPLED:
+            if (++events_since_validation >= invariant_sample_interval) {
+                events_since_validation = 0;
+                invariant_check();
+            } else {
+                check_no_crossing();
+            }
+            return;
+        case InvariantMode::FULL:
+            invariant_check();
+            return;
+    }
 }
 
 void OrderBook::place_limit_order(const Order& order) {
+    OperationScope scope(*this, EngineOp::PLACE_LIMIT);
     Order working_order = order;
-    
+
+    // Tick ladder mode only accepts prices inside its band
+    if (!snap_to_ladder(working_order)) {
+        reject_order(order, OrderEvent::PRICE_OUT_OF_BAND);
+        return;
+    }
+
     if (order.side == OrderSide::BUY) {
-        // Try to match against existing sell orders (resting orders)
-        while (working_order.quantity > 0 && !sell_orders.empty() && 
-               working_order.price >= sell_orders.begin()->first) {
-            
-            Price resting_price = sell_orders.begin()->first;
-            auto& sell_queue = sell_orders[resting_price];
-            Order& resting_order = sell_queue.front();
-            
-            Quantity trade_quantity = std::min(working_order.quantity, resting_order.quantity);
-            
-            // Execution price is the resting order's price
-            Price execution_price = resting_price;
-            
-            working_order.quantity -= trade_quantity;
-            resting_order.quantity -= trade_quantity;
-            
-            // Log the trade
-            trade_logs.push_back(Trade {
-                next_trade_id++,
-                working_order.order_id,
-                resting_order.order_id,
-                OrderSide::BUY,
-                working_order.trader_id,
-                resting_order.trader_id,
-                execution_price,
-                trade_quantity,
-                0
-            });
-            
-            // Log the trade for both orders
-            order_logs.push_back(OrderLog {
-                working_order.order_id,
-                working_order.trader_id,
-                execution_price,
-                trade_quantity,
-                OrderSide::BUY,
-                working_order.type,
-                (working_order.quantity == 0) ? OrderStatus::FILLED : OrderStatus::PARTIALLY_FILLED,
-                0,
-                std::string("Trade executed")
-            });
-            
-            order_logs.push_back(OrderLog {
-                resting_order.order_id,
-                resting_order.trader_id,
-                execution_price,
-                trade_quantity,
-                OrderSide::SELL,
-                resting_order.type,
-                (resting_order.quantity == 0) ? OrderStatus::FILLED : OrderStatus::PARTIALLY_FILLED,
-                0,
-                std::string("Trade executed")
-            });
-            
-            // Remove filled resting order
-            if (resting_order.quantity == 0) {
-                order_index.erase(resting_order.order_id);
-                sell_queue.erase(sell_queue.begin());
-                if (sell_queue.empty()) {
-                    sell_orders.erase(resting_price);
-                }
-            }
+        match_limit_order<OrderSide::BUY>(working_order);
+    } else {
+        match_limit_order<OrderSide::SELL>(working_order);
+    }
+}
+
+void OrderBook::reject_order(const Order& order, OrderEvent reason) {
+    event_sink->on_order_event(OrderLog {
+        order.order_id,
+        order.trader_id,
+        order.price,
+        0,
+        order.side,
+        order.type,
+        OrderStatus::UNFILLED,
+        reason,
+        0
+    });
+}
+
+template <OrderSide Side>
+bool OrderBook::has_liquidity(Price price, Quantity quantity) const {
+    using Traits = SideTraits<Side>;
+
+    std::uint64_t available = 0;
+    for_each_level(Traits::OPPOSITE, [&available, price, quantity](const LevelQueue& level) {
+        if (!Traits::crosses(price, level.price)) {
+            return false;
         }
-        
-        // Add remaining quantity to the book
-        if (working_order.quantity > 0) {
-            buy_orders[working_order.price].push_back(working_order);
-            order_index[working_order.order_id] = {working_order.price, OrderSide::BUY};
-            order_logs.push_back(OrderLog {
-                working_order.order_id,
-                working_order.trader_id,
-                working_order.price,
-                working_order.quantity,
-                working_order.side,
-                working_order.type,
-                OrderStatus::PLACED,
-                0,
-                std::string("Limit buy order placed")
-            });
+        available += level.total_quantity;
+        return available < quantity;
+    });
+    return available >= quantity;
+}
+
+bool OrderBook::can_fill(OrderSide side, Price price, Quantity quantity) const {
+    // Judge the price the order would actually trade at, an order outside the band never trades
+    Order probe{};
+    probe.side = side;
+    probe.price = price;
+    if (!snap_to_ladder(probe)) {
+        return false;
+    }
+    if (side == OrderSide::BUY) {
+        return has_liquidity<OrderSide::BUY>(probe.price, quantity);
+    }
+    return has_liquidity<OrderSide::SELL>(probe.price, quantity);
+}
+
+template <OrderSide Side>
+void OrderBook::match_limit_order(Order& working_order) {
+    using Traits = SideTraits<Side>;
+
+    // Post-only and fill-or-kill are decided before anything trades
+    if (working_order.type == OrderType::POST_ONLY) {
+        const LevelQueue* best_resting = best_level<Traits::OPPOSITE>();
+        if (best_resting != nullptr && Traits::crosses(working_order.price, best_resting->price)) {
+            reject_order(working_order, OrderEvent::POST_ONLY_REJECTED);
+            return;
         }
+    } else if (working_order.type == OrderType::FOK && !has_liquidity<Side>(working_order.price, working_order.quantity)) {
+        reject_order(working_order, OrderEvent::FOK_REJECTED);
+        return;
+    }
 
-        invariant_check();
+    // Try to match against the resting orders of the other side
+    while (working_order.quantity > 0) {
+        const LevelQueue* best_resting = best_level<Traits::OPPOSITE>();
+        if (best_resting == nullptr || !Traits::crosses(working_order.price, best_resting->price)) {
+            break;
+        }
 
-    } else {
-        // Try to match against existing buy orders (resting orders)
-        while (working_order.quantity > 0 && !buy_orders.empty() && 
-               working_order.price <= buy_orders.begin()->first) {
-            
-            Price resting_price = buy_orders.begin()->first;
-            auto& buy_queue = buy_orders[resting_price];
-            Order& resting_order = buy_queue.front();
-            
-            Quantity trade_quantity = std::min(working_order.quantity, resting_order.quantity);
-            
-            // Execution price is the resting order's price
-            Price execution_price = resting_price;
-            
-            working_order.quantity -= trade_quantity;
-            resting_order.quantity -= trade_quantity;
-            
-            // Log the trade
-            trade_logs.push_back(Trade {
-                next_trade_id++,
-                resting_order.order_id,
-                working_order.order_id,
-                OrderSide::SELL,
-                resting_order.trader_id,
-                working_order.trader_id,
-                execution_price,
-                trade_quantity,
-                0
-            });
-            
-            // Log the trade for both orders
-            order_logs.push_back(OrderLog {
+        Price resting_price = best_resting->price;
+        NodeHandle resting_handle = best_resting->head;
+        // Copy, the node is released below once it is filled
+        Order resting_order = order_store[resting_handle].order;
+
+        Quantity trade_quantity = std::min(working_order.quantity, resting_order.quantity);
+
+        // Execution price is the resting order's price
+        Price execution_price = resting_price;
+
+        working_order.quantity -= trade_quantity;
+        resting_order.quantity -= trade_quantity;
+        engine_stats.on_fill(best_resting);
+        Trade trade = Traits::trade(next_trade_id++, working_order, resting_order, execution_price, trade_quantity);
+
+        // Update the book before any sink runs, so a sink that throws leaves it consistent
+        order_store.reduce(resting_handle, trade_quantity);
+        if (resting_order.quantity == 0) {
+            remove_order<Traits::OPPOSITE>(resting_handle);
+        } else {
+            record_level_change(Traits::OPPOSITE, *order_store[resting_handle].level);
+        }
+
+        // Log the trade
+        event_sink->on_trade(trade);
+
+        // Log the trade for both orders
+        event_sink->on_order_event(OrderLog {
+            working_order.order_id,
+            working_order.trader_id,
+            execution_price,
+            trade_quantity,
+            Side,
+            working_order.type,
+            (working_order.quantity == 0) ? OrderStatus::FILLED : OrderStatus::PARTIALLY_FILLED,
+            OrderEvent::TRADE_EXECUTED,
+            0
+        });
+
+        event_sink->on_order_event(OrderLog {
+            resting_order.order_id,
+            resting_order.trader_id,
+            execution_price,
+            trade_quantity,
+            Traits::OPPOSITE,
+            resting_order.type,
+            (resting_order.quantity == 0) ? OrderStatus::FILLED : OrderStatus::PARTIALLY_FILLED,
+            OrderEvent::TRADE_EXECUTED,
+            0
+        });
+    }
+
+    if (working_order.quantity > 0) {
+        if (working_order.type == OrderType::IOC || working_order.type == OrderType::FOK) {
+            // IOC (and FOK, which never gets here unfilled) drops what did not trade
+            event_sink->on_order_event(OrderLog {
                 working_order.order_id,
                 working_order.trader_id,
-                execution_price,
-                trade_quantity,
-                OrderSide::SELL,
+                working_order.price,
+                working_order.quantity,
+                Side,
                 working_order.type,
-                (working_order.quantity == 0) ? OrderStatus::FILLED : OrderStatus::PARTIALLY_FILLED,
-                0,
-                std::string("Trade executed")
-            });
-            
-            order_logs.push_back(OrderLog {
-                resting_order.order_id,
-                resting_order.trader_id,
-                execution_price,
-                trade_quantity,
-                OrderSide::BUY,
-                resting_order.type,
-                (resting_order.quantity == 0) ? OrderStatus::FILLED : OrderStatus::PARTIALLY_FILLED,
-                0,
-                std::string("Trade executed")
+                OrderStatus::CANCELED,
+                OrderEvent::REMAINDER_CANCELED,
+                0
             });
-            
-            // Remove filled resting order
-            if (resting_order.quantity == 0) {
-                order_index.erase(resting_order.order_id);
-                buy_queue.erase(buy_queue.begin());
-                if (buy_queue.empty()) {
-                    buy_orders.erase(resting_price);
-                }
-            }
-        }
-        
-        // Add remaining quantity to the book
-        if (working_order.quantity > 0) {
-            sell_orders[working_order.price].push_back(working_order);
-            order_index[working_order.order_id] = {working_order.price, OrderSide::SELL};
-            order_logs.push_back(OrderLog {
+        } else {
+            // Add remaining quantity to the book
+            rest_order<Side>(working_order);
+            event_sink->on_order_event(OrderLog {
                 working_order.order_id,
                 working_order.trader_id,
                 working_order.price,
                 working_order.quantity,
-                working_order.side,
+                Side,
                 working_order.type,
                 OrderStatus::PLACED,
-                0,
-                std::string("Limit sell order placed")
+                OrderEvent::LIMIT_PLACED,
+                0
             });
         }
-
-        invariant_check();
     }
+
+    check_invariants_after_event();
 }
 
 Quantity OrderBook::get_total_quantity(OrderSide side) const {
     Quantity total_quantity = 0;
 
-    if (side == OrderSide::BUY) {
-        for (const auto& order : buy_orders) {
-            for (const auto& o : order.second) {
-                total_quantity += o.quantity;
-            }
-        }
-    } else {
-        for (const auto& order : sell_orders) {
-            for (const auto& o : order.second) {
-                total_quantity += o.quantity;
-            }
-        }
-    }
+    for_each_level(side, [&total_quantity](const LevelQueue& level) {
+        total_quantity += level.total_quantity;
+        return true;
+    });
 
     return total_quantity;
     
 }
 
 void OrderBook::place_market_order(const Order& order) {
+    OperationScope scope(*this, EngineOp::PLACE_MARKET);
     if (order.side == OrderSide::BUY) {
-        if (sell_orders.empty()) {
-            order_logs.push_back(OrderLog {
-                order.order_id,
-                order.trader_id,
-                0.0,
-                0,
-                order.side,
-                order.type,
-                OrderStatus::UNFILLED,
-                0,
-                std::string("No sell orders available")
-            });
-            return;
-        }
-    
-        Quantity remaining_quantity = order.quantity;
-        Price execution_price = 0.0;
-        std::vector<std::pair<Price, Quantity>> executions;
-
-        while (remaining_quantity > 0 && !sell_orders.empty()) {
-            Order& sell_order = sell_orders.begin()->second.front();
-            const Price& sell_price = sell_order.price;
-
-            Quantity trade_quantity = std::min(remaining_quantity, sell_order.quantity);
-            remaining_quantity -= trade_quantity;
-            sell_order.quantity -= trade_quantity;
-            executions.push_back({sell_price, trade_quantity});
-            
-            // Log each trade
-            trade_logs.push_back(Trade {
-                next_trade_id++,
-                order.order_id,
-                sell_order.order_id,
-                OrderSide::BUY,
-                order.trader_id,
-                sell_order.trader_id,
-                sell_price,
-                trade_quantity,
-                0
-            });
-
-            if (sell_order.quantity == 0) {
-                sell_orders.begin()->second.erase(sell_orders.begin()->second.begin());
-                if (sell_orders.begin()->second.empty()) {
-                    sell_orders.erase(sell_orders.begin());
-                };
-            };
-        }
+        match_market_order<OrderSide::BUY>(order);
+    } else {
+        match_market_order<OrderSide::SELL>(order);
+    }
+}
 
-        // compute average price of executions
-        if (!executions.empty()) {
-            double total_cost = 0.0;
-            Quantity total_executed = 0;
-            for (const auto& exec : executions) {
-                total_cost += exec.first * exec.second;
-                total_executed += exec.second;
-            }
-            execution_price = total_cost / total_executed;
-        }
+template <OrderSide Side>
+void OrderBook::match_market_order(const Order& order) {
+    using Traits = SideTraits<Side>;
 
-        order_logs.push_back(OrderLog {
+    if (best_level<Traits::OPPOSITE>() == nullptr) {
+        event_sink->on_order_event(OrderLog {
             order.order_id,
             order.trader_id,
-            execution_price,
-            order.quantity - remaining_quantity,
+            0.0,
+            0,
             order.side,
             order.type,
-            (remaining_quantity == 0) ? OrderStatus::FILLED : OrderStatus::PARTIALLY_FILLED,
-            0,
-            std::string("Market buy order executed")
+            OrderStatus::UNFILLED,
+            OrderEvent::NO_LIQUIDITY,
+            0
         });
+        return;
+    }
 
-    } else {
-        if (buy_orders.empty()) {
-            order_logs.push_back(OrderLog {
-                order.order_id,
-                order.trader_id,
-                0.0,
-                0,
-                order.side,
-                order.type,
-                OrderStatus::UNFILLED,
-                0,
-                std::string("No buy orders available")
-            });
-            return;
-        }
-
-        Quantity remaining_quantity = order.quantity;
-        Price execution_price = 0.0;
-        std::vector<std::pair<Price, Quantity>> executions;
-
-        while (remaining_quantity > 0 && !buy_orders.empty()) {
-            Order& buy_order = buy_orders.begin()->second.front();
-            const Price& buy_price = buy_order.price;
-
-            Quantity trade_quantity = std::min(remaining_quantity, buy_order.quantity);
-            remaining_quantity -= trade_quantity;
-            buy_order.quantity -= trade_quantity;
-            executions.push_back({buy_price, trade_quantity});
-            
-            // Log each trade
-            trade_logs.push_back(Trade {
-                next_trade_id++,
-                buy_order.order_id,
-                order.order_id,
-                OrderSide::SELL,
-                buy_order.trader_id,
-                order.trader_id,
-                buy_price,
-                trade_quantity,
-                0
-            });
+    Quantity remaining_quantity = order.quantity;
+    Price execution_price = 0.0;
+    double total_cost = 0.0;
 
-            if (buy_order.quantity == 0) {
-                buy_orders.begin()->second.erase(buy_orders.begin()->second.begin());
-                if (buy_orders.begin()->second.empty()) {
-                    buy_orders.erase(buy_orders.begin());
-                };
-            };
+    while (remaining_quantity > 0) {
+        const LevelQueue* best_resting = best_level<Traits::OPPOSITE>();
+        if (best_resting == nullptr) {
+            break;
         }
-
-        // compute average price of executions
-        if (!executions.empty()) {
-            double total_cost = 0.0;
-            Quantity total_executed = 0;
-            for (const auto& exec : executions) {
-                total_cost += exec.first * exec.second;
-                total_executed += exec.second;
-            }
-            execution_price = total_cost / total_executed;
+        NodeHandle resting_handle = best_resting->head;
+        const Order& resting_order = order_store[resting_handle].order;
+        const Price resting_price = resting_order.price;
+
+        Quantity trade_quantity = std::min(remaining_quantity, resting_order.quantity);
+        remaining_quantity -= trade_quantity;
+        total_cost += resting_price * trade_quantity;
+        engine_stats.on_fill(best_resting);
+        Trade trade = Traits::trade(next_trade_id++, order, resting_order, resting_price, trade_quantity);
+
+        // Update the book before the sink runs, so a sink that throws leaves it consistent
+        bool filled = trade_quantity == resting_order.quantity;
+        order_store.reduce(resting_handle, trade_quantity);
+        if (filled) {
+            remove_order<Traits::OPPOSITE>(resting_handle);
+        } else {
+            record_level_change(Traits::OPPOSITE, *order_store[resting_handle].level);
         }
 
-        order_logs.push_back(OrderLog {
-            order.order_id,
-            order.trader_id,
-            execution_price,
-            order.quantity - remaining_quantity,
-            order.side,
-            order.type,
-            (remaining_quantity == 0) ? OrderStatus::FILLED : OrderStatus::PARTIALLY_FILLED,
-            0,
-            std::string("Market sell order executed")
-        });
+        // Log each trade
+        event_sink->on_trade(trade);
     }
-    invariant_check();
+
+    // average price of the executions
+    if (remaining_quantity < order.quantity) {
+        execution_price = total_cost / (order.quantity - remaining_quantity);
+    }
+
+    event_sink->on_order_event(OrderLog {
+        order.order_id,
+        order.trader_id,
+        execution_price,
+        order.quantity - remaining_quantity,
+        order.side,
+        order.type,
+        (remaining_quantity == 0) ? OrderStatus::FILLED : OrderStatus::PARTIALLY_FILLED,
+        OrderEvent::MARKET_EXECUTED,
+        0
+    });
+
+    check_invariants_after_event();
 }
 
 void OrderBook::cancel_order(OrderID order_id) {
+    OperationScope scope(*this, EngineOp::CANCEL);
     // Use order index for O(1) lookup
-    auto index_it = order_index.find(order_id);
-    if (index_it == order_index.end()) {
+    NodeHandle handle = order_index.find(order_id);
+    if (handle == NULL_NODE) {
         return; // Order not found
     }
     
-    Price price = index_it->second.first;
-    OrderSide side = index_it->second.second;
-    
-    if (side == OrderSide::BUY) {
-        auto& orders = buy_orders[price];
-        auto order_it = std::find_if(orders.begin(), orders.end(),
-                                     [order_id](const Order& o) { return o.order_id == order_id; });
-        if (order_it != orders.end()) {
-            orders.erase(order_it);
-            if (orders.empty()) {
-                buy_orders.erase(price);
-            }
-            order_index.erase(order_id);
-            order_logs.push_back(OrderLog {
-                order_id,
-                0,
-                price,
-                0,
-                OrderSide::BUY,
-                OrderType::LIMIT,
-                OrderStatus::CANCELED,
-                0,
-                std::string("Buy order canceled")
-            });
-        }
-    } else {
-        auto& orders = sell_orders[price];
-        auto order_it = std::find_if(orders.begin(), orders.end(),
-                                     [order_id](const Order& o) { return o.order_id == order_id; });
-        if (order_it != orders.end()) {
-            orders.erase(order_it);
-            if (orders.empty()) {
-                sell_orders.erase(price);
-            }
-            order_index.erase(order_id);
-            order_logs.push_back(OrderLog {
-                order_id,
-                0,
-                price,
-                0,
-                OrderSide::SELL,
-                OrderType::LIMIT,
-                OrderStatus::CANCELED,
-                0,
-                std::string("Sell order canceled")
-            });
-        }
-    }
+    Price price = order_store[handle].order.price;
+    OrderSide side = order_store[handle].order.side;
+
+    remove_order(handle);
+
+    event_sink->on_order_event(OrderLog {
+        order_id,
+        0,
+        price,
+        0,
+        side,
+        OrderType::LIMIT,
+        OrderStatus::CANCELED,
+        OrderEvent::CANCELED,
+        0
+    });
 }
 
 double OrderBook::get_spread() const {
@@ -442,6 +515,7 @@ Price OrderBook::get_mid_price() const {
 }
 
 OrderBookSnapshot OrderBook::get_snapshot(Timestamp timestamp) const {
+    OperationScope scope(*this, EngineOp::SNAPSHOT);
     OrderBookSnapshot snapshot;
     snapshot.timestamp = timestamp;
     snapshot.best_bid = get_best_bid();
@@ -451,30 +525,25 @@ OrderBookSnapshot OrderBook::get_snapshot(Timestamp timestamp) const {
     
     // Build bid levels
     snapshot.total_bid_volume = 0;
-    for (const auto& [price, orders] : buy_orders) {
-        Quantity level_quantity = 0;
-        for (const auto& order : orders) {
-            level_quantity += order.quantity;
-        }
-        snapshot.bids.push_back(PriceLevel{price, level_quantity, static_cast<std::uint32_t>(orders.size())});
-        snapshot.total_bid_volume += level_quantity;
-    }
+    for_each_level(OrderSide::BUY, [&snapshot](const LevelQueue& level) {
+        snapshot.bids.push_back(PriceLevel{level.price, level.total_quantity, level.order_count});
+        snapshot.total_bid_volume += level.total_quantity;
+        return true;
+    });
     
     // Build ask levels
     snapshot.total_ask_volume = 0;
-    for (const auto& [price, orders] : sell_orders) {
-        Quantity level_quantity = 0;
-        for (const auto& order : orders) {
-            level_quantity += order.quantity;
-        }
-        snapshot.asks.push_back(PriceLevel{price, level_quantity, static_cast<std::uint32_t>(orders.size())});
-        snapshot.total_ask_volume += level_quantity;
-    }
+    for_each_level(OrderSide::SELL, [&snapshot](const LevelQueue& level) {
+        snapshot.asks.push_back(PriceLevel{level.price, level.total_quantity, level.order_count});
+        snapshot.total_ask_volume += level.total_quantity;
+        return true;
+    });
     
     return snapshot;
 }
 
 Level1Data OrderBook::get_level1_data() const {
+    OperationScope scope(*this, EngineOp::LEVEL1);
     Level1Data data;
     data.timestamp = current_time;
     data.bid_price = get_best_bid();
@@ -484,64 +553,72 @@ Level1Data OrderBook::get_level1_data() const {
     
     // Get quantities at best bid/ask
     data.bid_quantity = 0;
-    if (!buy_orders.empty()) {
-        for (const auto& order : buy_orders.begin()->second) {
-            data.bid_quantity += order.quantity;
-        }
+    if (const LevelQueue* best_bid = best_level(OrderSide::BUY)) {
+        data.bid_quantity = best_bid->total_quantity;
     }
     
     data.ask_quantity = 0;
-    if (!sell_orders.empty()) {
-        for (const auto& order : sell_orders.begin()->second) {
-            data.ask_quantity += order.quantity;
-        }
+    if (const LevelQueue* best_ask = best_level(OrderSide::SELL)) {
+        data.ask_quantity = best_ask->total_quantity;
     }
     
     return data;
 }
 
 Level2Data OrderBook::get_level2_data() const {
+    OperationScope scope(*this, EngineOp::LEVEL2);
     Level2Data data;
     data.timestamp = current_time;
     
     // Bids
-    for (const auto& [price, orders] : buy_orders) {
-        Quantity level_quantity = 0;
-        for (const auto& order : orders) {
-            level_quantity += order.quantity;
-        }
-        data.bids.push_back(PriceLevel{price, level_quantity, static_cast<std::uint32_t>(orders.size())});
-    }
+    for_each_level(OrderSide::BUY, [&data](const LevelQueue& level) {
+        data.bids.push_back(PriceLevel{level.price, level.total_quantity, level.order_count});
+        return true;
+    });
     
     // Asks
-    for (const auto& [price, orders] : sell_orders) {
-        Quantity level_quantity = 0;
-        for (const auto& order : orders) {
-            level_quantity += order.quantity;
-        }
-        data.asks.push_back(PriceLevel{price, level_quantity, static_cast<std::uint32_t>(orders.size())});
-    }
+    for_each_level(OrderSide::SELL, [&data](const LevelQueue& level) {
+        data.asks.push_back(PriceLevel{level.price, level.total_quantity, level.order_count});
+        return true;
+    });
     
     return data;
 }
 
+void OrderBook::enable_level2_updates(std::size_t capacity, std::uint64_t snapshot_interval) {
+    if (capacity == 0) {
+        throw std::runtime_error("Level 2 update capacity must be positive");
+    }
+    level_updates.enable(capacity);
+    level2_snapshot_interval = snapshot_interval;
+}
+
+Level2Updates OrderBook::get_level2_updates(std::uint64_t since_sequence) const {
+    if (!level_updates.enabled()) {
+        throw std::runtime_error("Level 2 updates are not enabled on this book");
+    }
+
+    Level2Updates result;
+    result.sequence = level_updates.last_sequence();
+    result.is_snapshot = false;
+
+    // Periodic resync: the caller's range crosses a snapshot boundary
+    bool snapshot_due = level2_snapshot_interval > 0 &&
+                        since_sequence / level2_snapshot_interval != result.sequence / level2_snapshot_interval;
+
+    if (since_sequence == 0 || snapshot_due || !level_updates.copy_since(since_sequence, result.updates)) {
+        result.updates.clear();
+        result.is_snapshot = true;
+        result.snapshot = get_level2_data();
+    }
+    return result;
+}
+
 Quantity OrderBook::get_depth_at_price(Price price, OrderSide side) const {
     Quantity total = 0;
     
-    if (side == OrderSide::BUY) {
-        auto it = buy_orders.find(price);
-        if (it != buy_orders.end()) {
-            for (const auto& order : it->second) {
-                total += order.quantity;
-            }
-        }
-    } else {
-        auto it = sell_orders.find(price);
-        if (it != sell_orders.end()) {
-            for (const auto& order : it->second) {
-                total += order.quantity;
-            }
-        }
+    if (const LevelQueue* level = find_level(side, price)) {
+        total = level->total_quantity;
     }
     
     return total;
@@ -551,17 +628,13 @@ std::vector<PriceLevel> OrderBook::get_bid_levels(size_t depth) const {
     std::vector<PriceLevel> levels;
     size_t count = 0;
     
-    for (const auto& [price, orders] : buy_orders) {
-        if (count >= depth) break;
+    for_each_level(OrderSide::BUY, [&levels, &count, depth](const LevelQueue& level) {
+        if (count >= depth) return false;
         
-        Quantity level_quantity = 0;
-        for (const auto& order : orders) {
-            level_quantity += order.quantity;
-        }
-        
-        levels.push_back(PriceLevel{price, level_quantity, static_cast<std::uint32_t>(orders.size())});
+        levels.push_back(PriceLevel{level.price, level.total_quantity, level.order_count});
         count++;
-    }
+        return true;
+    });
     
     return levels;
 }
@@ -570,63 +643,71 @@ std::vector<PriceLevel> OrderBook::get_ask_levels(size_t depth) const {
     std::vector<PriceLevel> levels;
     size_t count = 0;
     
-    for (const auto& [price, orders] : sell_orders) {
-        if (count >= depth) break;
+    for_each_level(OrderSide::SELL, [&levels, &count, depth](const LevelQueue& level) {
+        if (count >= depth) return false;
         
-        Quantity level_quantity = 0;
-        for (const auto& order : orders) {
-            level_quantity += order.quantity;
-        }
-        
-        levels.push_back(PriceLevel{price, level_quantity, static_cast<std::uint32_t>(orders.size())});
+        levels.push_back(PriceLevel{level.price, level.total_quantity, level.order_count});
         count++;
-    }
+        return true;
+    });
     
     return levels;
 }
 
+size_t OrderBook::copy_levels(OrderSide side, PriceLevel* out, size_t depth) const {
+    OperationScope scope(*this, EngineOp::LEVEL2);
+    size_t count = 0;
+    if (depth == 0) {
+        return 0;
+    }
+    for_each_level(side, [out, &count, depth](const LevelQueue& level) {
+        out[count++] = PriceLevel{level.price, level.total_quantity, level.order_count};
+        return count < depth;
+    });
+    return count;
+}
+
 void OrderBook::modify_order(OrderID order_id, Price new_price, Quantity new_quantity) {
-    // Find and remove the old order
-    Order old_order;
-    bool found = false;
-    
-    // Search in buy orders
-    for (auto it = buy_orders.begin(); it != buy_orders.end(); ++it) {
-        auto& orders = it->second;
-        auto order_it = std::find_if(orders.begin(), orders.end(),
-                                     [order_id](const Order& o) { return o.order_id == order_id; });
-        if (order_it != orders.end()) {
-            old_order = *order_it;
-            found = true;
-            orders.erase(order_it);
-            if (orders.empty()) {
-                buy_orders.erase(it);
-            }
-            break;
-        }
+    OperationScope scope(*this, EngineOp::MODIFY);
+    // Use order index for O(1) lookup
+    NodeHandle handle = order_index.find(order_id);
+    if (handle == NULL_NODE) {
+        return; // Order not found
     }
-    
-    // Search in sell orders if not found
-    if (!found) {
-        for (auto it = sell_orders.begin(); it != sell_orders.end(); ++it) {
-            auto& orders = it->second;
-            auto order_it = std::find_if(orders.begin(), orders.end(),
-                                         [order_id](const Order& o) { return o.order_id == order_id; });
-            if (order_it != orders.end()) {
-                old_order = *order_it;
-                found = true;
-                orders.erase(order_it);
-                if (orders.empty()) {
-                    sell_orders.erase(it);
-                }
-                break;
-            }
-        }
+
+    // Modifying down to nothing takes the order off the book, report it like a cancel
+    if (new_quantity == 0) {
+        cancel_order(order_id);
+        return;
     }
-    
-    if (!found) {
-        return; // Order not found
+
+    Order old_order = order_store[handle].order;
+
+    // Compare against the price the order would actually rest at
+    Order resized_order = old_order;
+    resized_order.price = new_price;
+    bool same_price = snap_to_ladder(resized_order) && resized_order.price == old_order.price;
+
+    // Quantity-down at the same price: reduce in place, the order keeps its queue position
+    if (same_price && new_quantity <= old_order.quantity) {
+        order_store.reduce(handle, old_order.quantity - new_quantity);
+        record_level_change(old_order.side, *order_store[handle].level);
+        event_sink->on_order_event(OrderLog {
+            order_id,
+            old_order.trader_id,
+            old_order.price,
+            new_quantity,
+            old_order.side,
+            old_order.type,
+            OrderStatus::PLACED,
+            OrderEvent::MODIFIED,
+            current_time
+        });
+        return;
     }
+
+    // Price change or quantity increase: remove and requeue
+    remove_order(handle);
     
     // Create modified order with new price and quantity
     Order modified_order = old_order;
@@ -636,40 +717,48 @@ void OrderBook::modify_order(OrderID order_id, Price new_price, Quantity new_qua
     
     // Place the modified order
     place_limit_order(modified_order);
-    
-    order_logs.push_back(OrderLog {
+
+    // Only an order that rests afterwards was modified. A requeue that filled completely or
+    // was rejected (post-only crossing, price out of band) already logged its terminal event
+    NodeHandle requeued = order_index.find(order_id);
+    if (requeued == NULL_NODE) {
+        return;
+    }
+    const Order& resting_order = order_store[requeued].order;
+
+    event_sink->on_order_event(OrderLog {
         order_id,
         old_order.trader_id,
-        new_price,
-        new_quantity,
+        resting_order.price,
+        resting_order.quantity,
         old_order.side,
         old_order.type,
         OrderStatus::PLACED,
-        current_time,
-        std::string("Order modified")
+        OrderEvent::MODIFIED,
+        current_time
     });
 }
 
 std::vector<Order> OrderBook::get_all_trader_orders(TraderID trader_id) const {
     std::vector<Order> trader_orders;
     
-    // Check buy orders
-    for (const auto& [price, orders] : buy_orders) {
-        for (const auto& order : orders) {
-            if (order.trader_id == trader_id) {
-                trader_orders.push_back(order);
-            }
+    auto collect = [&trader_orders, trader_id](const Order& order) {
+        if (order.trader_id == trader_id) {
+            trader_orders.push_back(order);
         }
-    }
+    };
+
+    // Check buy orders
+    for_each_level(OrderSide::BUY, [this, &collect](const LevelQueue& level) {
+        order_store.for_each(level, collect);
+        return true;
+    });
     
     // Check sell orders
-    for (const auto& [price, orders] : sell_orders) {
-        for (const auto& order : orders) {
-            if (order.trader_id == trader_id) {
-                trader_orders.push_back(order);
-            }
-        }
-    }
+    for_each_level(OrderSide::SELL, [this, &collect](const LevelQueue& level) {
+        order_store.for_each(level, collect);
+        return true;
+    });
     
     return trader_orders;
 }
\ No newline at end of file
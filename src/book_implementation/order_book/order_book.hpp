@@ -1,10 +1,44 @@
 #pragma once
 #include "types.hpp"
+#include "order_store.hpp"
+#include "order_index.hpp"
+#include "event_sink.hpp"
+#include "price_ladder.hpp"
+#include "level_update_log.hpp"
+#include "slab_allocator.hpp"
+#include "engine_stats.hpp"
 #include <map>
+#include <memory>
+#include <optional>
 #include <vector>
 #include <functional>
 #include <stdexcept>
 
+// How much book validation runs after each order event
+enum class InvariantMode {
+    OFF,      // No checks at all
+    CHEAP,    // O(1) best bid < best ask check after every order
+    SAMPLED,  // Cheap check every order, full scan every N order events
+    FULL      // Full scan of every resting order after every order
+};
+
+// Compile-time default, override with -DORDER_BOOK_DEFAULT_INVARIANT_MODE=InvariantMode::...
+#ifndef ORDER_BOOK_DEFAULT_INVARIANT_MODE
+#ifdef NDEBUG
+#define ORDER_BOOK_DEFAULT_INVARIANT_MODE InvariantMode::CHEAP
+#else
+#define ORDER_BOOK_DEFAULT_INVARIANT_MODE InvariantMode::FULL
+#endif
+#endif
+
+// Allocator of the price level map nodes, override with -DORDER_BOOK_LEVEL_ALLOCATOR=std::allocator
+#ifndef ORDER_BOOK_LEVEL_ALLOCATOR
+#define ORDER_BOOK_LEVEL_ALLOCATOR SlabAllocator
+#endif
+
+template <typename Compare>
+using LevelMap = std::map<Price, LevelQueue, Compare, ORDER_BOOK_LEVEL_ALLOCATOR<std::pair<const Price, LevelQueue>>>;
+
 /**
  * Limit Order Book with Price-Time Priority Matching
  * 
@@ -13,51 +47,245 @@
  * MATCHING ALGORITHM:
  * - Price-Time Priority: Orders are matched first by best price, then by time (FIFO within price level)
  * - Execution Price: Always uses the resting order's price (maker price), not the incoming order's price
+ * - Limit-priced types: LIMIT rests its remainder, IOC cancels it, FOK is checked against the level
+ *   aggregates first and trades in full or not at all, POST_ONLY is rejected if it would cross
  * - Immediate Matching: Incoming orders that cross the spread are matched immediately before being added to the book
  * 
  * DATA STRUCTURES:
  * - Buy Orders: std::map with std::greater<Price> for descending price order (best bid first)
  * - Sell Orders: std::map with std::less<Price> for ascending price order (best ask first)
- * - Within each price level: std::vector maintains FIFO order (front = earliest order)
- * - Order Index: std::map for O(1) order lookup by order_id (for cancellations/modifications)
+ * - Within each price level: intrusive doubly-linked FIFO queue through the OrderStore nodes (head = earliest order)
+ * - Order Index: flat open-addressing hash map from order_id to the order's node handle (O(1) cancel/modify lookup)
+ * - Cancel, fill-pop and in-place quantity reduction are O(1) once the node is known
+ * - Every level caches total_quantity and order_count, so L1 is O(1) and depth-N is O(N levels)
+ * - Map nodes come from a per-book slab pool and order nodes from the OrderStore free list, so
+ *   once the book has reached its peak size (or after reserve()) matching does no heap allocation
+ * - One matching loop per order type, templated on the aggressor side: the side is tested once
+ *   on entry and the crossing test, trade orientation and level containers are fixed at compile time
+ *
+ * TICK LADDER MODE (opt-in, constructed with a LadderConfig):
+ * - Prices are integer ticks inside a fixed band, each side is a PriceLadder (contiguous level array)
+ * - Best level is a cursor, next non-empty level is found with a bitmap scan
+ * - Limit prices are snapped onto the grid (bids down, asks up), prices outside the band are rejected
  * 
  * SIMULATION FEATURES:
  * - Timestamping: current_time tracks simulation clock
  * - Snapshots: Capture full order book state at any time
  * - Market Data: Level 1 (top of book) and Level 2 (depth) data available
+ * - Level 2 Deltas: opt-in log of changed levels, get_level2_updates() returns only the changes
  * - Trade Logging: Every trade is logged with both order IDs and execution details
  * - Order Logging: All order events (placed, filled, canceled, modified) are logged
+ * - Events go to a pluggable EventSink chosen at construction (memory by default, or
+ *   null, bounded ring, binary file, user callback); records are fixed-size PODs
+ *
+ * INSTRUMENTATION (built with -DORDER_BOOK_ENGINE_STATS=1, otherwise compiled out):
+ * - TSC ticks, fills, levels walked and storage growth per order management and market data call
+ *
+ * VALIDATION:
+ * - invariant_check() is a full O(book size) scan, scheduled by the InvariantMode
+ * - Release builds default to the O(1) no-crossing check, debug builds to a full scan per order
  */
 class OrderBook {
     private:
+        // Storage for every resting order, linked into per-level FIFO queues
+        OrderStore order_store;
+
         // FIFO queues at each price level (Price-Time Priority)
         // Buy orders: higher prices first (std::greater), then FIFO within price level
-        std::map<Price, std::vector<Order>, std::greater<Price>> buy_orders;
+        LevelMap<std::greater<Price>> buy_orders;
         // Sell orders: lower prices first (std::less by default), then FIFO within price level
-        std::map<Price, std::vector<Order>> sell_orders;
+        LevelMap<std::less<Price>> sell_orders;
+        
+        // Tick ladder mode replaces both maps when engaged
+        std::optional<PriceLadder> bid_ladder;
+        std::optional<PriceLadder> ask_ladder;
         
-        // Fast order lookup for cancellations/modifications - O(1) access
-        std::map<OrderID, std::pair<Price, OrderSide>> order_index;
+        // Fast order lookup for cancellations/modifications - order_id -> node handle
+        OrderIndex order_index;
 
         Price get_best_bid() const;
         Price get_best_ask() const;
         Quantity get_total_quantity(OrderSide side) const;
+
+        // One side's containers picked at compile time, for the side-templated matching core
+        template <OrderSide Side>
+        auto& levels_of() {
+            if constexpr (Side == OrderSide::BUY) {
+                return buy_orders;
+            } else {
+                return sell_orders;
+            }
+        }
+        template <OrderSide Side>
+        const auto& levels_of() const {
+            if constexpr (Side == OrderSide::BUY) {
+                return buy_orders;
+            } else {
+                return sell_orders;
+            }
+        }
+        template <OrderSide Side>
+        std::optional<PriceLadder>& ladder_of() {
+            if constexpr (Side == OrderSide::BUY) {
+                return bid_ladder;
+            } else {
+                return ask_ladder;
+            }
+        }
+        template <OrderSide Side>
+        const std::optional<PriceLadder>& ladder_of() const {
+            if constexpr (Side == OrderSide::BUY) {
+                return bid_ladder;
+            } else {
+                return ask_ladder;
+            }
+        }
+
+        // Level access shared by the map and tick ladder modes
+        template <OrderSide Side>
+        const LevelQueue* best_level() const;
+        const LevelQueue* best_level(OrderSide side) const;
+        const LevelQueue* find_level(OrderSide side, Price price) const;
+
+        // Visit the non-empty levels of one side best first, stop when fn returns false
+        template <typename Fn>
+        void for_each_level(OrderSide side, Fn&& fn) const {
+            if (side == OrderSide::BUY) {
+                if (bid_ladder) {
+                    bid_ladder->for_each_level(fn);
+                    return;
+                }
+                for (const auto& [price, level] : buy_orders) {
+                    if (!fn(level)) break;
+                }
+            } else {
+                if (ask_ladder) {
+                    ask_ladder->for_each_level(fn);
+                    return;
+                }
+                for (const auto& [price, level] : sell_orders) {
+                    if (!fn(level)) break;
+                }
+            }
+        }
+
+        // Snap a limit price onto the tick grid, false if it falls outside the band
+        bool snap_to_ladder(Order& order) const;
+
+        // Destination of every trade and order event
+        std::shared_ptr<EventSink> event_sink;
+
+        // Validation policy state
+        InvariantMode invariant_mode = ORDER_BOOK_DEFAULT_INVARIANT_MODE;
+        std::uint32_t invariant_sample_interval = 1024;
+        std::uint64_t events_since_validation = 0;
+
+        // Run whatever validation the invariant mode asks for after an order event
+        void check_invariants_after_event();
+
+        // Changed price levels for incremental Level 2 feeds (off until enabled)
+        LevelUpdateLog level_updates;
+        std::uint64_t level2_snapshot_interval = 0;
+
+        // Record a level's new aggregates after an add, fill, reduction or removal
+        void record_level_change(OrderSide side, const LevelQueue& level) {
+            if (level_updates.enabled()) {
+                level_updates.record(side, level.price, level.total_quantity, level.order_count, current_time);
+            }
+        }
+
+        // Append an order at the back of its price level and index it
+        template <OrderSide Side>
+        void rest_order(const Order& order);
+        // Unlink a resting order from its level, drop the level if it became empty
+        template <OrderSide Side>
+        void remove_order(NodeHandle handle);
+        void remove_order(NodeHandle handle);
+
+        // Log a limit order that was turned away before touching the book
+        void reject_order(const Order& order, OrderEvent reason);
+
+        // Whether the other side holds `quantity` at prices an order of Side at `price` trades at,
+        // summing level aggregates best first and stopping as soon as the answer is known
+        template <OrderSide Side>
+        bool has_liquidity(Price price, Quantity quantity) const;
+
+        // Matching core, written once and instantiated for each aggressor side
+        template <OrderSide Side>
+        void match_limit_order(Order& working_order);
+        template <OrderSide Side>
+        void match_market_order(const Order& order);
+
+        // Per-call instrumentation, NullEngineStats unless built with ORDER_BOOK_ENGINE_STATS=1.
+        // Mutable so const queries are timed as well, which makes concurrent reads of a stats
+        // build a data race: such a book is strictly single-threaded
+        mutable EngineStatsPolicy engine_stats;
+
+        // Capacity of the order store, the index and the level pools, grows on every allocation
+        std::size_t storage_footprint() const;
+
+        // Brackets one public call for engine_stats, compiles to nothing with NullEngineStats
+        class OperationScope {
+            private:
+                const OrderBook& book;
+
+            public:
+                OperationScope(const OrderBook& book, EngineOp op) : book(book) {
+                    if constexpr (EngineStatsPolicy::ENABLED) {
+                        book.engine_stats.begin(op, book.storage_footprint());
+                    }
+                }
+                ~OperationScope() {
+                    if constexpr (EngineStatsPolicy::ENABLED) {
+                        book.engine_stats.end([this] { return book.storage_footprint(); });
+                    }
+                }
+                OperationScope(const OperationScope&) = delete;
+                OperationScope& operator=(const OperationScope&) = delete;
+        };
     
     public:
-        std::vector<OrderLog> order_logs;
-        std::vector<Trade> trade_logs;
         TradeID next_trade_id = 1;
         Timestamp current_time = 0;  // Simulation clock
 
-        OrderBook() = default;
+        // A null event sink means the default in-memory MemorySink
+        explicit OrderBook(std::shared_ptr<EventSink> sink = nullptr)
+            : event_sink(sink ? std::move(sink) : std::make_shared<MemorySink>()) {}
+        explicit OrderBook(const LadderConfig& ladder_config, std::shared_ptr<EventSink> sink = nullptr)
+            : bid_ladder(std::in_place, ladder_config, OrderSide::BUY),
+              ask_ladder(std::in_place, ladder_config, OrderSide::SELL),
+              event_sink(sink ? std::move(sink) : std::make_shared<MemorySink>()) {}
         virtual ~OrderBook() = default;
 
+        // Order nodes point at their level, so a book can be moved but not copied
+        OrderBook(const OrderBook&) = delete;
+        OrderBook& operator=(const OrderBook&) = delete;
+        OrderBook(OrderBook&&) = default;
+        OrderBook& operator=(OrderBook&&) = default;
+
+        bool is_ladder_mode() const { return bid_ladder.has_value(); }
+
+        // Pre-size the order store, the order index and the level pools so that a book
+        // holding up to `orders` resting orders on up to `levels` prices per side never allocates
+        void reserve(std::size_t orders, std::size_t levels);
+
+        EventSink& get_event_sink() const { return *event_sink; }
+
         // Order management
+        // Handles every limit-priced type (LIMIT, IOC, FOK, POST_ONLY) according to order.type
         void place_limit_order(const Order& order);
         void place_market_order(const Order& order);
         void cancel_order(OrderID order_id);
+        // Same price with a smaller (non-zero) quantity is done in place and keeps queue priority,
+        // a price change or a quantity increase requeues the order at the back of its new level.
+        // MODIFIED is logged with the resting price and quantity, and not at all when the requeue
+        // filled completely or was rejected. A new quantity of 0 cancels the order (CANCELED)
         void modify_order(OrderID order_id, Price new_price, Quantity new_quantity);
 
+        // True if a `side` order limited to `price` would fill `quantity` right now. Costs
+        // O(levels it has to look at), reads level aggregates only and changes nothing
+        bool can_fill(OrderSide side, Price price, Quantity quantity) const;
+
         // Market data queries
         double get_spread() const;
         Price get_mid_price() const;
@@ -65,12 +293,29 @@ class OrderBook {
         Level1Data get_level1_data() const;
         Level2Data get_level2_data() const;
 
+        // Start logging changed levels; readers further than `capacity` changes behind, or
+        // crossing a multiple of `snapshot_interval` (0 = never), get a full snapshot instead
+        void enable_level2_updates(std::size_t capacity = 1 << 16, std::uint64_t snapshot_interval = 0);
+        bool level2_updates_enabled() const { return level_updates.enabled(); }
+        // Level changes after `since_sequence`, or a full snapshot (since_sequence == 0 always is one)
+        Level2Updates get_level2_updates(std::uint64_t since_sequence) const;
+
         std::vector<Order> get_all_trader_orders(TraderID trader_id) const;
         
         // Order book depth at specific price levels
         Quantity get_depth_at_price(Price price, OrderSide side) const;
         std::vector<PriceLevel> get_bid_levels(size_t depth = 10) const;
         std::vector<PriceLevel> get_ask_levels(size_t depth = 10) const;
+        // Best `depth` levels of one side written to `out` without allocating, returns the count
+        size_t copy_levels(OrderSide side, PriceLevel* out, size_t depth) const;
+        // Bounded-depth snapshot into caller-owned storage, meant to be reused across polls
+        template <std::size_t K>
+        void fill_depth(DepthN<K>& out) const {
+            OperationScope scope(*this, EngineOp::LEVEL2);
+            out.timestamp = current_time;
+            out.bid_count = static_cast<std::uint32_t>(copy_levels(OrderSide::BUY, out.bids.data(), K));
+            out.ask_count = static_cast<std::uint32_t>(copy_levels(OrderSide::SELL, out.asks.data(), K));
+        }
         
         // Time management for simulations
         void advance_time(Timestamp new_time) { current_time = new_time; }
@@ -80,35 +325,73 @@ class OrderBook {
             buy_orders.clear();
             sell_orders.clear();
             order_index.clear();
-            order_logs.clear();
-            trade_logs.clear();
+            order_store.clear();
+            if (bid_ladder) {
+                bid_ladder->clear();
+                ask_ladder->clear();
+            }
+            event_sink->clear();
+            level_updates.invalidate();
             next_trade_id = 1;
         }
 
+        // Per-operation counters and histograms (enabled == false when compiled out)
+        EngineStats get_engine_stats() const { return engine_stats.stats(); }
+        void reset_engine_stats() { engine_stats.reset(); }
+
+        // Validation scheduling, sample_interval is only used by InvariantMode::SAMPLED
+        void set_invariant_mode(InvariantMode mode, std::uint32_t sample_interval = 1024) {
+            invariant_mode = mode;
+            invariant_sample_interval = sample_interval == 0 ? 1 : sample_interval;
+            events_since_validation = 0;
+        }
+        InvariantMode get_invariant_mode() const { return invariant_mode; }
+
+        // O(1): best bid must be below best ask, otherwise orders should have matched
+        void check_no_crossing() const {
+            const LevelQueue* best_bid = best_level(OrderSide::BUY);
+            const LevelQueue* best_ask = best_level(OrderSide::SELL);
+            if (best_bid != nullptr && best_ask != nullptr && best_bid->price >= best_ask->price) {
+                throw std::runtime_error("Invariant violation: Best bid >= best ask (orders should have matched)");
+            }
+        }
+
+        // Full validation pass over every resting order, O(book size)
         void invariant_check() const {
             // check every order for negative quantity or price
-            for (const auto& [price, orders] : buy_orders) {
-                for (const auto& order : orders) {
+            for_each_level(OrderSide::BUY, [this](const LevelQueue& level) {
+                Quantity level_quantity = 0;
+                std::uint32_t order_count = 0;
+                order_store.for_each(level, [&level_quantity, &order_count](const Order& order) {
                     if (order.quantity == 0 || order.price <= 0.0) {
                         throw std::runtime_error("Invariant violation: Invalid buy order");
                     }
+                    level_quantity += order.quantity;
+                    order_count++;
+                });
+                if (level_quantity != level.total_quantity || order_count != level.order_count) {
+                    throw std::runtime_error("Invariant violation: Stale buy level aggregates");
                 }
-            }
-            for (const auto& [price, orders] : sell_orders) {
-                for (const auto& order : orders) {
+                return true;
+            });
+            for_each_level(OrderSide::SELL, [this](const LevelQueue& level) {
+                Quantity level_quantity = 0;
+                std::uint32_t order_count = 0;
+                order_store.for_each(level, [&level_quantity, &order_count](const Order& order) {
                     if (order.quantity == 0 || order.price <= 0.0) {
                         throw std::runtime_error("Invariant violation: Invalid sell order");
                     }
+                    level_quantity += order.quantity;
+                    order_count++;
+                });
+                if (level_quantity != level.total_quantity || order_count != level.order_count) {
+                    throw std::runtime_error("Invariant violation: Stale sell level aggregates");
                 }
-            }
+                return true;
+            });
 
             // check that best bid is less than best ask (no crossing)
-            // If best_bid >= best_ask, orders should have matched
-            if (!buy_orders.empty() && !sell_orders.empty()) {
-                if (get_best_bid() >= get_best_ask()) {
-                    throw std::runtime_error("Invariant violation: Best bid >= best ask (orders should have matched)");
-                }
-            }
+            check_no_crossing();
         }
 
 };
\ No newline at end of file
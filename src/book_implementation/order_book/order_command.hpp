@@ -0,0 +1,85 @@
+#pragma once
+#include "order_book.hpp"
+#include <cstdint>
+#include <type_traits>
+
+// =========================================================================
+// Order Book Commands
+// =========================================================================
+
+enum class CommandType : std::uint8_t {
+    LIMIT,
+    MARKET,
+    CANCEL,
+    MODIFY,  // price / quantity are the new values
+    IOC,
+    FOK,
+    POST_ONLY
+};
+
+// One order book request as a POD record: copied through the matching engine's ingress ring
+// and stored as-is in binary replay files
+struct OrderCommand {
+    OrderID order_id;
+    TraderID trader_id;
+    Price price;
+    Quantity quantity;
+    CommandType type;
+    OrderSide side;
+    Timestamp timestamp;
+};
+static_assert(std::is_trivially_copyable<OrderCommand>::value, "OrderCommand must stay a POD record");
+
+// Command that places an order of this type
+inline CommandType order_command_type(OrderType type) {
+    switch (type) {
+        case OrderType::MARKET: return CommandType::MARKET;
+        case OrderType::IOC: return CommandType::IOC;
+        case OrderType::FOK: return CommandType::FOK;
+        case OrderType::POST_ONLY: return CommandType::POST_ONLY;
+        default: return CommandType::LIMIT;
+    }
+}
+
+// Order type placed by a LIMIT, MARKET, IOC, FOK or POST_ONLY command
+inline OrderType command_order_type(CommandType type) {
+    switch (type) {
+        case CommandType::MARKET: return OrderType::MARKET;
+        case CommandType::IOC: return OrderType::IOC;
+        case CommandType::FOK: return OrderType::FOK;
+        case CommandType::POST_ONLY: return OrderType::POST_ONLY;
+        default: return OrderType::LIMIT;
+    }
+}
+
+// Hand one command to the book
+inline void apply_command(OrderBook& book, const OrderCommand& command) {
+    switch (command.type) {
+        case CommandType::LIMIT:
+        case CommandType::MARKET:
+        case CommandType::IOC:
+        case CommandType::FOK:
+        case CommandType::POST_ONLY: {
+            Order order;
+            order.order_id = command.order_id;
+            order.trader_id = command.trader_id;
+            order.price = command.type == CommandType::MARKET ? 0.0 : command.price;
+            order.quantity = command.quantity;
+            order.side = command.side;
+            order.type = command_order_type(command.type);
+            order.timestamp = command.timestamp;
+            if (order.type == OrderType::MARKET) {
+                book.place_market_order(order);
+            } else {
+                book.place_limit_order(order);
+            }
+            break;
+        }
+        case CommandType::CANCEL:
+            book.cancel_order(command.order_id);
+            break;
+        case CommandType::MODIFY:
+            book.modify_order(command.order_id, command.price, command.quantity);
+            break;
+    }
+}
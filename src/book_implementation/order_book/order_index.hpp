@@ -0,0 +1,152 @@
+#pragma once
+#include "types.hpp"
+#include "order_store.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// =========================================================================
+// Order Index
+// =========================================================================
+
+/**
+ * Flat open-addressing hash map from OrderID to the order's node handle.
+ *
+ * Slots live in a single power-of-two array and collisions are resolved with linear
+ * probing, so a lookup is usually one or two cache lines. Erase uses backward-shift
+ * deletion instead of tombstones, which keeps probe sequences short under heavy
+ * cancel/replace churn. The table doubles once it is half full.
+ *
+ * An empty slot is marked by value == NULL_NODE, so every OrderID is a valid key.
+ */
+class OrderIndex {
+    private:
+        struct Slot {
+            OrderID key;
+            NodeHandle value;
+        };
+
+        std::vector<Slot> slots;
+        std::size_t mask = 0;
+        unsigned shift = 64;   // 64 - log2(slots.size())
+        std::size_t count = 0;
+
+        // Fibonacci hashing: the top log2(size) bits of the product depend on every bit of the
+        // key, so ids that differ only in their high bits (per-agent id ranges) still spread
+        std::size_t home(OrderID key) const {
+            return static_cast<std::size_t>((static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15ULL) >> shift);
+        }
+
+        static unsigned shift_for(std::size_t size) {
+            unsigned bits = 0;
+            while ((std::size_t(1) << bits) < size) {
+                bits++;
+            }
+            return 64 - bits;
+        }
+
+        void rehash(std::size_t capacity) {
+            std::vector<Slot> old_slots(capacity, Slot{0, NULL_NODE});
+            old_slots.swap(slots);
+            mask = capacity - 1;
+            shift = shift_for(capacity);
+            count = 0;
+            for (const Slot& slot : old_slots) {
+                if (slot.value != NULL_NODE) {
+                    insert(slot.key, slot.value);
+                }
+            }
+        }
+
+    public:
+        explicit OrderIndex(std::size_t capacity = 1024) {
+            std::size_t size = 16;
+            while (size < capacity * 2) {
+                size <<= 1;
+            }
+            slots.assign(size, Slot{0, NULL_NODE});
+            mask = size - 1;
+            shift = shift_for(size);
+        }
+
+        // Room for `capacity` keys without rehashing
+        void reserve(std::size_t capacity) {
+            std::size_t size = slots.size();
+            while (size < capacity * 2) {
+                size <<= 1;
+            }
+            if (size != slots.size()) {
+                rehash(size);
+            }
+        }
+
+        std::size_t size() const { return count; }
+        std::size_t capacity() const { return slots.size(); }
+        bool empty() const { return count == 0; }
+
+        // Node handle for the order, NULL_NODE if the order is not resting
+        NodeHandle find(OrderID key) const {
+            for (std::size_t i = home(key);; i = (i + 1) & mask) {
+                const Slot& slot = slots[i];
+                if (slot.value == NULL_NODE) {
+                    return NULL_NODE;
+                }
+                if (slot.key == key) {
+                    return slot.value;
+                }
+            }
+        }
+
+        // Insert or overwrite the handle for an order
+        void insert(OrderID key, NodeHandle value) {
+            if ((count + 1) * 2 > slots.size()) {
+                rehash(slots.size() * 2);
+            }
+            for (std::size_t i = home(key);; i = (i + 1) & mask) {
+                Slot& slot = slots[i];
+                if (slot.value == NULL_NODE) {
+                    slot = Slot{key, value};
+                    count++;
+                    return;
+                }
+                if (slot.key == key) {
+                    slot.value = value;
+                    return;
+                }
+            }
+        }
+
+        bool erase(OrderID key) {
+            std::size_t i = home(key);
+            while (true) {
+                if (slots[i].value == NULL_NODE) {
+                    return false;
+                }
+                if (slots[i].key == key) {
+                    break;
+                }
+                i = (i + 1) & mask;
+            }
+
+            // Shift later members of the probe run back so no lookup hits a hole
+            std::size_t hole = i;
+            for (std::size_t j = (hole + 1) & mask; slots[j].value != NULL_NODE; j = (j + 1) & mask) {
+                std::size_t k = home(slots[j].key);
+                bool reachable = (hole <= j) ? (hole < k && k <= j) : (hole < k || k <= j);
+                if (!reachable) {
+                    slots[hole] = slots[j];
+                    hole = j;
+                }
+            }
+            slots[hole].value = NULL_NODE;
+            count--;
+            return true;
+        }
+
+        void clear() {
+            for (Slot& slot : slots) {
+                slot.value = NULL_NODE;
+            }
+            count = 0;
+        }
+};
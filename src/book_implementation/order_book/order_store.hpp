@@ -0,0 +1,140 @@
+#pragma once
+#include "types.hpp"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// =========================================================================
+// Order Node Store
+// =========================================================================
+
+// Handle to an order node inside the OrderStore (index into the node array)
+using NodeHandle = std::uint32_t;
+constexpr NodeHandle NULL_NODE = std::numeric_limits<NodeHandle>::max();
+
+struct LevelQueue;
+
+// Resting order together with its intrusive links in the price level FIFO
+struct OrderNode {
+    Order order;
+    NodeHandle prev = NULL_NODE;
+    NodeHandle next = NULL_NODE;
+    LevelQueue* level = nullptr;  // Level the order is queued at (nullptr when free)
+};
+
+// FIFO queue of resting orders at a single price level (head = earliest order)
+// Aggregates are maintained by the OrderStore on every add, fill and removal
+struct LevelQueue {
+    Price price = 0.0;
+    NodeHandle head = NULL_NODE;
+    NodeHandle tail = NULL_NODE;
+    Quantity total_quantity = 0;
+    std::uint32_t order_count = 0;
+
+    bool empty() const { return head == NULL_NODE; }
+};
+
+/**
+ * Node storage for all resting orders of a book.
+ *
+ * Nodes live in one contiguous array and are addressed by NodeHandle, so handles stay
+ * valid when the array grows. Released nodes go onto a free list and are reused by the
+ * next allocation. Every price level is a doubly-linked list threaded through the nodes,
+ * which makes append, unlink from any position and pop from the front all O(1). The level's
+ * total_quantity and order_count are kept in step with every list and quantity change.
+ *
+ * Note: references returned by operator[] are invalidated by allocate().
+ */
+class OrderStore {
+    private:
+        std::vector<OrderNode> nodes;
+        std::vector<NodeHandle> free_nodes;
+
+    public:
+        NodeHandle allocate(const Order& order) {
+            NodeHandle handle;
+            if (!free_nodes.empty()) {
+                handle = free_nodes.back();
+                free_nodes.pop_back();
+                nodes[handle] = OrderNode{};
+            } else {
+                handle = static_cast<NodeHandle>(nodes.size());
+                nodes.emplace_back();
+            }
+            nodes[handle].order = order;
+            return handle;
+        }
+
+        // Slots allocated in both arrays, only ever grows
+        std::size_t capacity() const { return nodes.capacity() + free_nodes.capacity(); }
+
+        // Room for `count` live orders without growing either array
+        void reserve(std::size_t count) {
+            nodes.reserve(count);
+            free_nodes.reserve(count);
+        }
+
+        void release(NodeHandle handle) {
+            nodes[handle].level = nullptr;
+            free_nodes.push_back(handle);
+        }
+
+        OrderNode& operator[](NodeHandle handle) { return nodes[handle]; }
+        const OrderNode& operator[](NodeHandle handle) const { return nodes[handle]; }
+
+        // Append a node at the back of the level queue (lowest time priority)
+        void push_back(LevelQueue& level, NodeHandle handle) {
+            OrderNode& node = nodes[handle];
+            node.level = &level;
+            node.prev = level.tail;
+            node.next = NULL_NODE;
+            if (level.tail != NULL_NODE) {
+                nodes[level.tail].next = handle;
+            } else {
+                level.head = handle;
+            }
+            level.tail = handle;
+            level.total_quantity += node.order.quantity;
+            level.order_count++;
+        }
+
+        // Take quantity off a resting order (fill or size-down), the order keeps its place
+        void reduce(NodeHandle handle, Quantity quantity) {
+            OrderNode& node = nodes[handle];
+            node.order.quantity -= quantity;
+            node.level->total_quantity -= quantity;
+        }
+
+        // Remove a node from whichever position it holds in its level queue
+        void unlink(NodeHandle handle) {
+            OrderNode& node = nodes[handle];
+            LevelQueue& level = *node.level;
+            if (node.prev != NULL_NODE) {
+                nodes[node.prev].next = node.next;
+            } else {
+                level.head = node.next;
+            }
+            if (node.next != NULL_NODE) {
+                nodes[node.next].prev = node.prev;
+            } else {
+                level.tail = node.prev;
+            }
+            node.prev = NULL_NODE;
+            node.next = NULL_NODE;
+            level.total_quantity -= node.order.quantity;
+            level.order_count--;
+        }
+
+        // Visit the orders of a level in FIFO order
+        template <typename Fn>
+        void for_each(const LevelQueue& level, Fn&& fn) const {
+            for (NodeHandle handle = level.head; handle != NULL_NODE; handle = nodes[handle].next) {
+                fn(nodes[handle].order);
+            }
+        }
+
+        void clear() {
+            nodes.clear();
+            free_nodes.clear();
+        }
+};
@@ -0,0 +1,209 @@
+#pragma once
+#include "types.hpp"
+#include "order_store.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// =========================================================================
+// Tick Ladder Configuration
+// =========================================================================
+
+// Opt-in configuration for the array-indexed (tick ladder) book mode
+struct LadderConfig {
+    Price tick_size = 0.01;    // Minimum price increment
+    Price min_price = 0.01;    // Lowest price accepted by the book (tick 0)
+    Price max_price = 1000.0;  // Highest price accepted by the book
+};
+
+/**
+ * One side of a tick-based order book.
+ *
+ * Prices are mapped to integer ticks, tick = (price - min_price) / tick_size, and every tick
+ * in the configured band owns a LevelQueue in one contiguous array. A bitmap marks the
+ * non-empty levels and a cursor tracks the best one, so finding the best level is O(1) and
+ * finding the next level after the best one empties is a word-wise bit scan.
+ *
+ * Level prices are precomputed from the tick, so equal ticks always compare equal
+ * (10.1 and 10.100000001 end up on the same level).
+ */
+class PriceLadder {
+    public:
+        static constexpr Tick NO_TICK = -1;
+
+    private:
+        Price tick_size;
+        Price min_price;
+        Tick tick_count;
+        bool descending;  // Bids: best = highest tick, asks: best = lowest tick
+        std::vector<LevelQueue> levels;
+        std::vector<std::uint64_t> occupied;
+        Tick best = NO_TICK;
+
+        static int lowest_bit(std::uint64_t word) {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward64(&index, word);
+            return static_cast<int>(index);
+#else
+            return __builtin_ctzll(word);
+#endif
+        }
+
+        static int highest_bit(std::uint64_t word) {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanReverse64(&index, word);
+            return static_cast<int>(index);
+#else
+            return 63 - __builtin_clzll(word);
+#endif
+        }
+
+        // First occupied tick strictly below `from`
+        Tick scan_down(Tick from) const {
+            if (from <= 0) {
+                return NO_TICK;
+            }
+            Tick tick = from - 1;
+            std::size_t word = static_cast<std::size_t>(tick >> 6);
+            int bit = static_cast<int>(tick & 63);
+            std::uint64_t bits = occupied[word] & (bit == 63 ? ~0ULL : ((1ULL << (bit + 1)) - 1));
+            while (true) {
+                if (bits != 0) {
+                    return static_cast<Tick>(word * 64 + highest_bit(bits));
+                }
+                if (word == 0) {
+                    return NO_TICK;
+                }
+                bits = occupied[--word];
+            }
+        }
+
+        // First occupied tick strictly above `from`
+        Tick scan_up(Tick from) const {
+            Tick tick = from + 1;
+            if (tick >= tick_count) {
+                return NO_TICK;
+            }
+            std::size_t word = static_cast<std::size_t>(tick >> 6);
+            std::uint64_t bits = occupied[word] & (~0ULL << (tick & 63));
+            while (true) {
+                if (bits != 0) {
+                    return static_cast<Tick>(word * 64 + lowest_bit(bits));
+                }
+                if (++word == occupied.size()) {
+                    return NO_TICK;
+                }
+                bits = occupied[word];
+            }
+        }
+
+        bool better(Tick a, Tick b) const { return descending ? a > b : a < b; }
+
+    public:
+        PriceLadder(const LadderConfig& config, OrderSide side)
+            : tick_size(config.tick_size),
+              min_price(config.min_price),
+              descending(side == OrderSide::BUY) {
+            if (config.tick_size <= 0.0 || config.min_price <= 0.0 || config.max_price < config.min_price) {
+                throw std::invalid_argument("Invalid ladder configuration");
+            }
+            tick_count = static_cast<Tick>(std::floor((config.max_price - config.min_price) / tick_size + 1e-9)) + 1;
+            levels.resize(static_cast<std::size_t>(tick_count));
+            for (Tick tick = 0; tick < tick_count; ++tick) {
+                levels[static_cast<std::size_t>(tick)].price = to_price(tick);
+            }
+            occupied.assign(static_cast<std::size_t>((tick_count + 63) / 64), 0);
+        }
+
+        // Ladders hand out pointers into `levels`, so they may move but never copy
+        PriceLadder(const PriceLadder&) = delete;
+        PriceLadder& operator=(const PriceLadder&) = delete;
+        PriceLadder(PriceLadder&&) = default;
+        PriceLadder& operator=(PriceLadder&&) = default;
+
+        Price to_price(Tick tick) const { return min_price + static_cast<Price>(tick) * tick_size; }
+
+        // Nearest tick for a price already on the grid, NO_TICK if off-grid or outside the band
+        Tick find_tick(Price price) const {
+            double position = (price - min_price) / tick_size;
+            double nearest = std::round(position);
+            if (std::fabs(position - nearest) > 1e-6 || nearest < 0.0 || nearest >= static_cast<double>(tick_count)) {
+                return NO_TICK;
+            }
+            return static_cast<Tick>(nearest);
+        }
+
+        // Snap a limit price onto the grid without making it more aggressive:
+        // bids round down, asks round up. Returns NO_TICK if the result is outside the band.
+        Tick snap_tick(Price price) const {
+            double position = (price - min_price) / tick_size;
+            double snapped = descending ? std::floor(position + 1e-9) : std::ceil(position - 1e-9);
+            if (snapped < 0.0 || snapped >= static_cast<double>(tick_count)) {
+                return NO_TICK;
+            }
+            return static_cast<Tick>(snapped);
+        }
+
+        bool empty() const { return best == NO_TICK; }
+
+        LevelQueue& level_at(Tick tick) { return levels[static_cast<std::size_t>(tick)]; }
+        Tick tick_of(const LevelQueue& level) const { return static_cast<Tick>(&level - levels.data()); }
+
+        const LevelQueue* best_level() const {
+            return best == NO_TICK ? nullptr : &levels[static_cast<std::size_t>(best)];
+        }
+
+        const LevelQueue* find(Price price) const {
+            Tick tick = find_tick(price);
+            if (tick == NO_TICK || levels[static_cast<std::size_t>(tick)].empty()) {
+                return nullptr;
+            }
+            return &levels[static_cast<std::size_t>(tick)];
+        }
+
+        // Next non-empty tick after `tick` in priority order (worse price)
+        Tick next_tick(Tick tick) const { return descending ? scan_down(tick) : scan_up(tick); }
+
+        void mark_occupied(Tick tick) {
+            occupied[static_cast<std::size_t>(tick >> 6)] |= (1ULL << (tick & 63));
+            if (best == NO_TICK || better(tick, best)) {
+                best = tick;
+            }
+        }
+
+        void mark_empty(Tick tick) {
+            occupied[static_cast<std::size_t>(tick >> 6)] &= ~(1ULL << (tick & 63));
+            if (tick == best) {
+                best = next_tick(tick);
+            }
+        }
+
+        // Visit non-empty levels best first, stop when fn returns false
+        template <typename Fn>
+        void for_each_level(Fn&& fn) const {
+            for (Tick tick = best; tick != NO_TICK; tick = next_tick(tick)) {
+                if (!fn(levels[static_cast<std::size_t>(tick)])) {
+                    break;
+                }
+            }
+        }
+
+        void clear() {
+            for (auto& level : levels) {
+                level.head = NULL_NODE;
+                level.tail = NULL_NODE;
+                level.total_quantity = 0;
+                level.order_count = 0;
+            }
+            std::fill(occupied.begin(), occupied.end(), 0);
+            best = NO_TICK;
+        }
+};
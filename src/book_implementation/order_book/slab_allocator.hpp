@@ -0,0 +1,152 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// =========================================================================
+// Slab Pool Allocation
+// =========================================================================
+
+/**
+ * Fixed-size block pool backing the book's node containers.
+ *
+ * Blocks of one size are carved out of slabs of BLOCKS_PER_SLAB and threaded onto an
+ * intrusive free list; deallocate() pushes a block back onto that list and allocate() pops
+ * it again, so a container that keeps inserting and erasing nodes stops touching the heap
+ * once its peak size has been reached. Slabs are only returned when the arena is destroyed.
+ *
+ * An arena belongs to one book and is not thread-safe, like the book itself.
+ */
+class SlabArena {
+    private:
+        static constexpr std::size_t BLOCKS_PER_SLAB = 256;
+
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        struct SizeClass {
+            std::size_t block_size;
+            std::size_t alignment;
+            FreeBlock* free_list = nullptr;
+        };
+
+        struct Slab {
+            void* memory;
+            std::size_t alignment;
+        };
+
+        std::vector<SizeClass> classes;   // Usually exactly one: the container's node size
+        std::vector<Slab> slabs;
+
+        SizeClass& size_class(std::size_t size, std::size_t alignment) {
+            alignment = std::max(alignment, alignof(FreeBlock));
+            std::size_t block_size = std::max(size, sizeof(FreeBlock));
+            block_size = (block_size + alignment - 1) / alignment * alignment;
+            for (SizeClass& existing : classes) {
+                if (existing.block_size == block_size && existing.alignment == alignment) {
+                    return existing;
+                }
+            }
+            classes.push_back(SizeClass{block_size, alignment, nullptr});
+            return classes.back();
+        }
+
+        void grow(SizeClass& blocks) {
+            void* memory = ::operator new(blocks.block_size * BLOCKS_PER_SLAB, std::align_val_t(blocks.alignment));
+            slabs.push_back(Slab{memory, blocks.alignment});
+            auto* bytes = static_cast<unsigned char*>(memory);
+            for (std::size_t i = BLOCKS_PER_SLAB; i > 0; --i) {
+                auto* block = reinterpret_cast<FreeBlock*>(bytes + (i - 1) * blocks.block_size);
+                block->next = blocks.free_list;
+                blocks.free_list = block;
+            }
+        }
+
+    public:
+        SlabArena() = default;
+        SlabArena(const SlabArena&) = delete;
+        SlabArena& operator=(const SlabArena&) = delete;
+
+        ~SlabArena() {
+            for (const Slab& slab : slabs) {
+                ::operator delete(slab.memory, std::align_val_t(slab.alignment));
+            }
+        }
+
+        void* allocate(std::size_t size, std::size_t alignment) {
+            SizeClass& blocks = size_class(size, alignment);
+            if (blocks.free_list == nullptr) {
+                grow(blocks);
+            }
+            FreeBlock* block = blocks.free_list;
+            blocks.free_list = block->next;
+            return block;
+        }
+
+        void deallocate(void* pointer, std::size_t size, std::size_t alignment) {
+            SizeClass& blocks = size_class(size, alignment);
+            auto* block = static_cast<FreeBlock*>(pointer);
+            block->next = blocks.free_list;
+            blocks.free_list = block;
+        }
+
+        std::size_t slab_count() const { return slabs.size(); }
+};
+
+/**
+ * Standard allocator handing out single nodes from a SlabArena.
+ *
+ * Node containers (std::map, std::set, std::list) only ever allocate one node at a time;
+ * anything else falls through to the global heap. Rebound copies share the arena, so a map
+ * and its node type draw from the same pool, while a copied container gets a fresh arena.
+ */
+template <typename T>
+class SlabAllocator {
+    template <typename U>
+    friend class SlabAllocator;
+
+    private:
+        std::shared_ptr<SlabArena> arena;
+
+    public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        SlabAllocator() : arena(std::make_shared<SlabArena>()) {}
+        // Copies (including the copy a moved-from container keeps) share the arena, there
+        // is deliberately no move constructor that would leave an allocator without one
+        SlabAllocator(const SlabAllocator& other) = default;
+        template <typename U>
+        SlabAllocator(const SlabAllocator<U>& other) : arena(other.arena) {}
+
+        SlabAllocator select_on_container_copy_construction() const { return SlabAllocator(); }
+
+        T* allocate(std::size_t n) {
+            if (n != 1) {
+                return std::allocator<T>().allocate(n);
+            }
+            return static_cast<T*>(arena->allocate(sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* pointer, std::size_t n) {
+            if (n != 1) {
+                std::allocator<T>().deallocate(pointer, n);
+                return;
+            }
+            arena->deallocate(pointer, sizeof(T), alignof(T));
+        }
+
+        const SlabArena& get_arena() const { return *arena; }
+
+        template <typename U>
+        bool operator==(const SlabAllocator<U>& other) const { return arena == other.arena; }
+        template <typename U>
+        bool operator!=(const SlabAllocator<U>& other) const { return arena != other.arena; }
+};
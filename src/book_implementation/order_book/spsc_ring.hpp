@@ -0,0 +1,82 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+// =========================================================================
+// SPSC Ring
+// =========================================================================
+
+/**
+ * Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ *
+ * Capacity is rounded up to a power of two so positions wrap with a mask. The producer owns
+ * `tail`, the consumer owns `head`, and each side keeps a cached copy of the other's index
+ * on its own cache line, so in steady state a push or pop touches no shared line except
+ * when the cached index says the ring looks full / empty.
+ */
+template <typename T>
+class SpscRing {
+    static_assert(std::is_trivially_copyable<T>::value, "SpscRing only stores POD records");
+
+    private:
+        static constexpr std::size_t CACHE_LINE = 64;
+
+        std::unique_ptr<T[]> slots;
+        std::size_t mask;
+
+        alignas(CACHE_LINE) std::atomic<std::size_t> head{0};  // Next slot to read
+        alignas(CACHE_LINE) std::size_t cached_tail = 0;        // Consumer's view of tail
+        alignas(CACHE_LINE) std::atomic<std::size_t> tail{0};  // Next slot to write
+        alignas(CACHE_LINE) std::size_t cached_head = 0;        // Producer's view of head
+
+    public:
+        explicit SpscRing(std::size_t capacity) {
+            std::size_t size = 2;
+            while (size < capacity) {
+                size <<= 1;
+            }
+            slots.reset(new T[size]);
+            mask = size - 1;
+        }
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        std::size_t capacity() const { return mask + 1; }
+
+        // Producer side, false if the ring is full
+        bool try_push(const T& record) {
+            std::size_t write = tail.load(std::memory_order_relaxed);
+            if (write - cached_head > mask) {
+                cached_head = head.load(std::memory_order_acquire);
+                if (write - cached_head > mask) {
+                    return false;
+                }
+            }
+            slots[write & mask] = record;
+            tail.store(write + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side, false if the ring is empty
+        bool try_pop(T& record) {
+            std::size_t read = head.load(std::memory_order_relaxed);
+            if (read == cached_tail) {
+                cached_tail = tail.load(std::memory_order_acquire);
+                if (read == cached_tail) {
+                    return false;
+                }
+            }
+            record = slots[read & mask];
+            head.store(read + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Approximate when called while the other side is active
+        std::size_t size() const {
+            return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+        }
+        bool empty() const { return size() == 0; }
+};
@@ -1,23 +1,29 @@
 #pragma once
+#include <array>
+#include <cstddef>
 #include <string>
 #include <cstdint>
+#include <type_traits>
 #include <vector>
 
 // =========================================================================
 // Order Book Data Types
 // =========================================================================
 
-enum class OrderSide {
+enum class OrderSide : std::uint8_t {
     BUY,
     SELL
 };
 
-enum class OrderType {
+enum class OrderType : std::uint8_t {
     LIMIT,
-    MARKET
+    MARKET,
+    IOC,        // Limit price, trades what it can right away, the rest is canceled
+    FOK,        // Limit price, trades the whole quantity right away or nothing at all
+    POST_ONLY   // Limit order that is rejected instead of trading if it would cross
 };
 
-enum class OrderStatus {
+enum class OrderStatus : std::uint8_t {
     PLACED,
     PARTIALLY_FILLED,
     FILLED,
@@ -25,9 +31,24 @@ enum class OrderStatus {
     CANCELED
 };
 
+// What happened to an order, rendered to text only on demand (see order_event_details)
+enum class OrderEvent : std::uint8_t {
+    LIMIT_PLACED,       // Limit order (remainder) rested in the book
+    TRADE_EXECUTED,     // One fill of a limit order, aggressor or resting side
+    MARKET_EXECUTED,    // Market order done, price is the average execution price
+    NO_LIQUIDITY,       // Market order hit an empty opposite side
+    CANCELED,           // Resting order canceled
+    MODIFIED,           // Resting order modified
+    PRICE_OUT_OF_BAND,  // Limit price outside the tick ladder band
+    REMAINDER_CANCELED, // Untraded rest of an IOC order dropped instead of resting
+    FOK_REJECTED,       // Not enough liquidity up to the FOK price, nothing traded
+    POST_ONLY_REJECTED  // Post-only order would have crossed the spread
+};
+
 using OrderID = std::uint64_t;
 using TraderID = std::uint64_t;
 using Price = double;
+using Tick = std::int64_t; // Integer price in ticks (tick ladder book mode)
 using Quantity = std::uint32_t;
 using Timestamp = std::uint64_t; // Unix timestamp in milliseconds
 using TradeID = std::uint64_t;
@@ -44,6 +65,7 @@ struct Order {
 };
 
 // Log entry for an order event
+// Fixed-size POD (40 bytes), so logging a fill never touches the heap
 struct OrderLog {
     OrderID order_id;
     TraderID trader_id;
@@ -52,9 +74,32 @@ struct OrderLog {
     OrderSide side;
     OrderType type;
     OrderStatus status;
+    OrderEvent event;    // What happened, see order_event_details() for the text
     Timestamp timestamp; // Unix timestamp in milliseconds
-    std::string details; // Additional details about the order event
 };
+static_assert(std::is_trivially_copyable<OrderLog>::value, "OrderLog must stay a POD record");
+
+// Human-readable description of an order event
+inline const char* order_event_details(OrderEvent event, OrderSide side) {
+    bool buy = (side == OrderSide::BUY);
+    switch (event) {
+        case OrderEvent::LIMIT_PLACED:      return buy ? "Limit buy order placed" : "Limit sell order placed";
+        case OrderEvent::TRADE_EXECUTED:    return "Trade executed";
+        case OrderEvent::MARKET_EXECUTED:   return buy ? "Market buy order executed" : "Market sell order executed";
+        case OrderEvent::NO_LIQUIDITY:      return buy ? "No sell orders available" : "No buy orders available";
+        case OrderEvent::CANCELED:          return buy ? "Buy order canceled" : "Sell order canceled";
+        case OrderEvent::MODIFIED:          return "Order modified";
+        case OrderEvent::PRICE_OUT_OF_BAND: return "Limit order price outside ladder band";
+        case OrderEvent::REMAINDER_CANCELED: return "Unfilled IOC quantity canceled";
+        case OrderEvent::FOK_REJECTED:      return "Not enough liquidity to fill FOK order";
+        case OrderEvent::POST_ONLY_REJECTED: return "Post-only order would cross the spread";
+    }
+    return "";
+}
+
+inline const char* order_event_details(const OrderLog& log) {
+    return order_event_details(log.event, log.side);
+}
 
 // Log entry for a trade execution
 struct Trade {
@@ -68,6 +113,7 @@ struct Trade {
     Quantity quantity;
     Timestamp timestamp; // Unix timestamp in milliseconds
 };
+static_assert(std::is_trivially_copyable<Trade>::value, "Trade must stay a POD record");
 
 // Market data structures for agents/analysis
 struct PriceLevel {
@@ -107,3 +153,33 @@ struct Level2Data {
     std::vector<PriceLevel> asks;  // Sorted ascending (best ask first)
 };
 
+// Best K levels per side in fixed-size storage, refilled in place by OrderBook::fill_depth
+template <std::size_t K>
+struct DepthN {
+    Timestamp timestamp;
+    std::uint32_t bid_count;          // Valid entries at the front of bids
+    std::uint32_t ask_count;          // Valid entries at the front of asks
+    std::array<PriceLevel, K> bids;   // Best bid first
+    std::array<PriceLevel, K> asks;   // Best ask first
+};
+
+// One changed price level, total_quantity == 0 means the level is gone
+struct LevelUpdate {
+    std::uint64_t sequence;  // Increases by one per change
+    Timestamp timestamp;
+    Price price;
+    Quantity total_quantity;
+    std::uint32_t order_count;
+    OrderSide side;
+};
+static_assert(std::is_trivially_copyable<LevelUpdate>::value, "LevelUpdate must stay a POD record");
+
+// Answer to a Level 2 delta request: either the changes since the caller's sequence,
+// or a full snapshot to resynchronise from
+struct Level2Updates {
+    std::uint64_t sequence;  // Last change covered, pass it as since_sequence next time
+    bool is_snapshot;
+    Level2Data snapshot;     // Only filled when is_snapshot
+    std::vector<LevelUpdate> updates;  // Only filled when !is_snapshot, oldest first
+};
+
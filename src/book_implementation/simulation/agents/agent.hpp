@@ -0,0 +1,50 @@
+#pragma once
+#include "../../order_book/types.hpp"
+#include <stdexcept>
+
+class Simulator;
+
+// =============================================
+// Native Agent Interface
+// =============================================
+
+/**
+ * Trading agent driven by Simulator::run() entirely in C++.
+ *
+ * Every tick the simulator calls on_market_data() with the current top of book, the agent
+ * queues its orders through the simulator (place_limit_order / place_market_order /
+ * cancel_order), then the queued orders are submitted and every trade the agent took part
+ * in is reported through on_fill(). Each agent must have its own trader id, and order ids
+ * are drawn from its own id range so agents never collide.
+ */
+class Agent {
+    private:
+        TraderID trader_id;
+        OrderID next_id;
+        OrderID end_id;
+
+    protected:
+        // Next unused order id of this agent's range [first_order_id, last_order_id)
+        OrderID get_new_id() {
+            if (next_id >= end_id) {
+                throw std::runtime_error("No available IDs in the specified range.");
+            }
+            return next_id++;
+        }
+
+    public:
+        Agent(TraderID trader_id, OrderID first_order_id, OrderID last_order_id)
+            : trader_id(trader_id), next_id(first_order_id), end_id(last_order_id) {}
+        virtual ~Agent() = default;
+
+        TraderID get_trader_id() const { return trader_id; }
+
+        // Decide and queue this tick's orders
+        virtual void on_market_data(const Level1Data& market_data, Simulator& simulator) = 0;
+
+        // One of this agent's orders traded; `side` is the agent's side of the trade
+        virtual void on_fill(const Trade& trade, OrderSide side) {
+            (void)trade;
+            (void)side;
+        }
+};
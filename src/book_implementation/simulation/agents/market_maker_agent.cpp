@@ -0,0 +1,56 @@
+#include "market_maker_agent.hpp"
+#include "../simulator.hpp"
+#include <algorithm>
+
+MarketMakerAgent::MarketMakerAgent(TraderID trader_id, OrderID first_order_id, OrderID last_order_id,
+                                   Price half_spread, Quantity quote_quantity,
+                                   std::int64_t max_inventory, Price inventory_skew,
+                                   Price initial_price)
+    : Agent(trader_id, first_order_id, last_order_id),
+      half_spread(half_spread),
+      quote_quantity(quote_quantity),
+      max_inventory(max_inventory),
+      inventory_skew(inventory_skew),
+      reference_price(initial_price) {}
+
+// Replace last tick's quotes with fresh ones around the (skewed) mid
+void MarketMakerAgent::on_market_data(const Level1Data& market_data, Simulator& simulator) {
+    if (market_data.mid_price > 0) {
+        reference_price = market_data.mid_price;
+    }
+
+    // Cancelling an order that already filled is a no-op
+    if (bid_order_id != 0) {
+        simulator.cancel_order(bid_order_id);
+        bid_order_id = 0;
+    }
+    if (ask_order_id != 0) {
+        simulator.cancel_order(ask_order_id);
+        ask_order_id = 0;
+    }
+
+    Price center = reference_price - inventory_skew * static_cast<Price>(inventory);
+    Price bid_price = center - half_spread;
+    Price ask_price = center + half_spread;
+
+    if (inventory < max_inventory && bid_price > 0.0) {
+        bid_order_id = get_new_id();
+        simulator.place_limit_order(PendingOrder{bid_order_id, get_trader_id(), bid_price, quote_quantity, OrderSide::BUY});
+    }
+    if (inventory > -max_inventory) {
+        ask_order_id = get_new_id();
+        simulator.place_limit_order(PendingOrder{ask_order_id, get_trader_id(), std::max(ask_price, 0.01), quote_quantity, OrderSide::SELL});
+    }
+}
+
+// Track inventory and cash
+void MarketMakerAgent::on_fill(const Trade& trade, OrderSide side) {
+    double notional = trade.price * static_cast<double>(trade.quantity);
+    if (side == OrderSide::BUY) {
+        inventory += trade.quantity;
+        cash -= notional;
+    } else {
+        inventory -= trade.quantity;
+        cash += notional;
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "agent.hpp"
+#include <cstdint>
+
+// =============================================
+// Market Maker Agent
+// =============================================
+
+// Quotes one bid and one ask around the mid price every tick, replacing last tick's quotes.
+// Quotes are skewed against the current inventory, and a side stops quoting once the
+// inventory limit is reached in that direction.
+class MarketMakerAgent : public Agent {
+    private:
+        Price half_spread;
+        Quantity quote_quantity;
+        std::int64_t max_inventory;
+        Price inventory_skew;    // Price shift per unit of inventory
+        Price reference_price;   // Last known mid, used while one book side is empty
+
+        OrderID bid_order_id = 0;   // 0 = no quote resting
+        OrderID ask_order_id = 0;
+
+        std::int64_t inventory = 0;
+        double cash = 0.0;
+
+    public:
+        MarketMakerAgent(TraderID trader_id, OrderID first_order_id, OrderID last_order_id,
+                         Price half_spread = 0.05, Quantity quote_quantity = 10,
+                         std::int64_t max_inventory = 100, Price inventory_skew = 0.0,
+                         Price initial_price = 10.0);
+
+        void on_market_data(const Level1Data& market_data, Simulator& simulator) override;
+        void on_fill(const Trade& trade, OrderSide side) override;
+
+        std::int64_t get_inventory() const { return inventory; }
+        double get_cash() const { return cash; }
+};
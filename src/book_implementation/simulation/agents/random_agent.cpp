@@ -0,0 +1,51 @@
+#include "random_agent.hpp"
+#include "../simulator.hpp"
+#include <algorithm>
+
+RandomAgent::RandomAgent(TraderID trader_id, OrderID first_order_id, OrderID last_order_id,
+                         std::uint64_t seed, double trading_probability, Price min_price)
+    : Agent(trader_id, first_order_id, last_order_id),
+      rng(seed),
+      trading_probability(trading_probability),
+      min_price(min_price),
+      mid_price(min_price) {}
+
+// Decide on random trades
+void RandomAgent::on_market_data(const Level1Data& market_data, Simulator& simulator) {
+    if (market_data.mid_price > 0) {
+        mid_price = market_data.mid_price;
+    } else {
+        mid_price = std::max(mid_price, min_price);
+    }
+
+    // Check if we should trade this cycle
+    if (uniform() >= trading_probability) {
+        return;
+    }
+
+    int trade_count = 1 + static_cast<int>(rng() % 5);
+    for (int i = 0; i < trade_count; ++i) {
+        OrderSide side = (rng() & 1) ? OrderSide::SELL : OrderSide::BUY;
+        Quantity quantity = 1 + static_cast<Quantity>(rng() % 10);
+        Price price = std::max(min_price, mid_price * (1.0 + (uniform() * 0.1 - 0.05)));
+
+        // Prevent self-trading: sell above our best bid, buy below our best ask
+        if (side == OrderSide::SELL && best_bid > 0) {
+            price = std::max(price, best_bid + 0.01);
+        } else if (side == OrderSide::BUY && best_ask < std::numeric_limits<Price>::infinity()) {
+            price = std::min(price, best_ask - 0.01);
+        }
+
+        // Ensure price is always valid (at least min_price)
+        price = std::max(price, min_price);
+
+        simulator.place_limit_order(PendingOrder{get_new_id(), get_trader_id(), price, quantity, side});
+
+        // Update our best bid/ask based on the order we just placed
+        if (side == OrderSide::BUY) {
+            best_bid = std::max(best_bid, price);
+        } else {
+            best_ask = std::min(best_ask, price);
+        }
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "agent.hpp"
+#include <limits>
+#include <random>
+
+// =============================================
+// Random Agent
+// =============================================
+
+// Native port of agents/random_agent.py: places a few random limit orders around the mid
+// price on some ticks, never crossing its own resting quotes. Seeded, so runs replay exactly.
+class RandomAgent : public Agent {
+    private:
+        std::mt19937_64 rng;
+        double trading_probability;
+        Price min_price;
+        Price mid_price;
+
+        // Track own orders to prevent self-trading
+        Price best_bid = 0.0;                                       // Highest price we're willing to buy at
+        Price best_ask = std::numeric_limits<Price>::infinity();    // Lowest price we're willing to sell at
+
+        // Uniform draw in [0, 1)
+        double uniform() { return static_cast<double>(rng() >> 11) * 0x1.0p-53; }
+
+    public:
+        RandomAgent(TraderID trader_id, OrderID first_order_id, OrderID last_order_id,
+                    std::uint64_t seed = 0, double trading_probability = 0.35, Price min_price = 0.01);
+
+        void on_market_data(const Level1Data& market_data, Simulator& simulator) override;
+};
@@ -0,0 +1,118 @@
+#include "batch_runner.hpp"
+#include "work_stealing_pool.hpp"
+#include "agents/random_agent.hpp"
+#include "agents/market_maker_agent.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Keeps running trade totals instead of the trades themselves
+class TradeStatsSink : public EventSink {
+    public:
+        std::uint64_t trade_count = 0;
+        std::uint64_t volume = 0;
+        double notional = 0.0;
+
+        void on_trade(const Trade& trade) override {
+            trade_count++;
+            volume += trade.quantity;
+            notional += trade.price * static_cast<double>(trade.quantity);
+        }
+        void on_order_event(const OrderLog&) override {}
+};
+
+// Derive independent agent seeds from the replica seed
+std::uint64_t splitmix64(std::uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Nearest-rank quantile of sorted samples
+double quantile(const std::vector<double>& sorted, double q) {
+    std::size_t rank = static_cast<std::size_t>(std::ceil(q * static_cast<double>(sorted.size())));
+    return sorted[std::min(sorted.size() - 1, rank == 0 ? 0 : rank - 1)];
+}
+
+} // namespace
+
+ReplicaStats run_replica(const ScenarioSpec& spec, const ReplicaParams& params) {
+    auto stats_sink = std::make_shared<TradeStatsSink>();
+    Simulator sim = spec.ladder ? Simulator(0, *spec.ladder, stats_sink) : Simulator(0, stats_sink);
+    sim.set_invariant_mode(spec.invariant_mode);
+
+    double trading_probability = params.trading_probability.value_or(spec.trading_probability);
+    Price half_spread = params.half_spread.value_or(spec.half_spread);
+    Price inventory_skew = params.inventory_skew.value_or(spec.inventory_skew);
+
+    // Agent order ids come from disjoint ranges above the opening quotes' ids
+    constexpr OrderID ID_RANGE = OrderID(1) << 40;
+    sim.place_limit_order(PendingOrder{1, 0, spec.initial_bid, spec.initial_quantity, OrderSide::BUY});
+    sim.place_limit_order(PendingOrder{2, 0, spec.initial_ask, spec.initial_quantity, OrderSide::SELL});
+    sim.submit_pending_orders();
+
+    for (std::uint32_t i = 0; i < spec.num_random_agents; ++i) {
+        sim.add_agent(std::make_shared<RandomAgent>(i + 1, (i + 1) * ID_RANGE, (i + 2) * ID_RANGE,
+                                                    splitmix64(params.seed + i), trading_probability));
+    }
+    std::shared_ptr<MarketMakerAgent> market_maker;
+    if (spec.market_maker) {
+        OrderID first_id = (OrderID(spec.num_random_agents) + 1) * ID_RANGE;
+        market_maker = std::make_shared<MarketMakerAgent>(spec.num_random_agents + 1, first_id, first_id + ID_RANGE,
+                                                          half_spread, spec.quote_quantity, spec.max_inventory,
+                                                          inventory_skew, (spec.initial_bid + spec.initial_ask) / 2.0);
+        sim.add_agent(market_maker);
+    }
+
+    std::vector<double> spreads;
+    spreads.reserve(spec.n_ticks);
+    for (std::uint64_t tick = 0; tick < spec.n_ticks; ++tick) {
+        sim.run(1, spec.time_step);
+        Level1Data top = sim.get_current_level1_data();
+        if (top.mid_price > 0.0) {
+            spreads.push_back(top.spread);
+        }
+    }
+
+    ReplicaStats stats{};
+    stats.seed = params.seed;
+    stats.trade_count = stats_sink->trade_count;
+    stats.volume = stats_sink->volume;
+    stats.vwap = stats_sink->volume > 0 ? stats_sink->notional / static_cast<double>(stats_sink->volume) : 0.0;
+    stats.final_mid = sim.get_current_level1_data().mid_price;
+    if (market_maker) {
+        stats.final_inventory = market_maker->get_inventory();
+        stats.final_cash = market_maker->get_cash();
+    }
+
+    stats.spread_samples = spreads.size();
+    if (!spreads.empty()) {
+        double sum = 0.0;
+        double sum_sq = 0.0;
+        for (double spread : spreads) {
+            sum += spread;
+            sum_sq += spread * spread;
+        }
+        double n = static_cast<double>(spreads.size());
+        stats.spread_mean = sum / n;
+        stats.spread_std = std::sqrt(std::max(0.0, sum_sq / n - stats.spread_mean * stats.spread_mean));
+        std::sort(spreads.begin(), spreads.end());
+        stats.spread_p5 = quantile(spreads, 0.05);
+        stats.spread_p50 = quantile(spreads, 0.50);
+        stats.spread_p95 = quantile(spreads, 0.95);
+    }
+    return stats;
+}
+
+std::vector<ReplicaStats> run_batch(const ScenarioSpec& spec, const std::vector<ReplicaParams>& replicas,
+                                    std::size_t num_threads) {
+    std::vector<ReplicaStats> results(replicas.size());
+    WorkStealingPool pool(std::min(num_threads == 0 ? std::size_t(std::thread::hardware_concurrency()) : num_threads,
+                                   std::max<std::size_t>(replicas.size(), 1)));
+    pool.parallel_for(replicas.size(), [&](std::size_t i) {
+        results[i] = run_replica(spec, replicas[i]);
+    });
+    return results;
+}
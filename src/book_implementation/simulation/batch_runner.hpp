@@ -0,0 +1,66 @@
+#pragma once
+#include "simulator.hpp"
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// =============================================
+// Monte-Carlo Batch Runner
+// =============================================
+
+// Scenario every replica of a batch runs: a seeded book, random agents and a market maker
+struct ScenarioSpec {
+    std::uint64_t n_ticks = 1000;
+    Timestamp time_step = 1;
+    std::optional<LadderConfig> ladder;
+    InvariantMode invariant_mode = InvariantMode::CHEAP;
+
+    // Opening quotes placed before the first tick (as in simulator.py)
+    Price initial_bid = 10.0;
+    Price initial_ask = 15.0;
+    Quantity initial_quantity = 100;
+
+    // Random agents
+    std::uint32_t num_random_agents = 10;
+    double trading_probability = 0.35;   // Default of every replica, see ReplicaParams
+
+    // Market maker (its statistics are the replica's final inventory / cash)
+    bool market_maker = true;
+    Price half_spread = 0.05;
+    Quantity quote_quantity = 10;
+    std::int64_t max_inventory = 100;
+    Price inventory_skew = 0.0;
+};
+
+// Per-replica overrides of the scenario, unset fields take the ScenarioSpec value
+struct ReplicaParams {
+    std::uint64_t seed = 0;
+    std::optional<double> trading_probability;
+    std::optional<Price> half_spread;
+    std::optional<Price> inventory_skew;
+};
+
+// Aggregated outcome of one replica
+struct ReplicaStats {
+    std::uint64_t seed;
+    std::uint64_t trade_count;
+    std::uint64_t volume;
+    double vwap;             // 0 without trades
+    // Distribution of the top of book spread, sampled after every tick with both sides quoted
+    std::uint64_t spread_samples;
+    double spread_mean;
+    double spread_std;
+    double spread_p5;
+    double spread_p50;
+    double spread_p95;
+    double final_mid;
+    std::int64_t final_inventory;  // Market maker position, 0 without a market maker
+    double final_cash;             // Market maker cash
+};
+
+// Run one replica of the scenario
+ReplicaStats run_replica(const ScenarioSpec& spec, const ReplicaParams& params);
+
+// Run independent replicas on a work-stealing pool, results in the order of `replicas`
+std::vector<ReplicaStats> run_batch(const ScenarioSpec& spec, const std::vector<ReplicaParams>& replicas,
+                                    std::size_t num_threads = 0);
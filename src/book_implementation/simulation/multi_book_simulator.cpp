@@ -0,0 +1,168 @@
+#include "multi_book_simulator.hpp"
+#include <stdexcept>
+
+// =============================================
+// Multi-Book Simulator Implementation
+// =============================================
+
+MultiBookSimulator::MultiBookSimulator(const MultiBookConfig& config, Timestamp start_time)
+    : config(config), pool(config.num_threads), simulation_time(start_time) {
+    if (config.num_books == 0) {
+        throw std::runtime_error("MultiBookSimulator needs at least one book");
+    }
+    books.reserve(config.num_books);
+    trade_marks.assign(config.num_books, 0);
+    order_log_marks.assign(config.num_books, 0);
+    for (std::size_t i = 0; i < config.num_books; ++i) {
+        books.push_back(std::make_unique<Book>(config));
+        books.back()->order_book.advance_time(simulation_time);
+    }
+}
+
+MultiBookSimulator::Book& MultiBookSimulator::book(InstrumentID instrument) {
+    if (instrument >= books.size()) {
+        throw std::runtime_error("Unknown instrument id " + std::to_string(instrument));
+    }
+    return *books[instrument];
+}
+
+const MultiBookSimulator::Book& MultiBookSimulator::book(InstrumentID instrument) const {
+    if (instrument >= books.size()) {
+        throw std::runtime_error("Unknown instrument id " + std::to_string(instrument));
+    }
+    return *books[instrument];
+}
+
+// Route a limit order to its instrument's pending buffer
+void MultiBookSimulator::place_limit_order(InstrumentID instrument, const PendingOrder& pending_order) {
+    if (pending_order.type == OrderType::MARKET) {
+        throw std::runtime_error("PendingOrder needs a limit-priced type, use place_market_order for market orders");
+    }
+    Order order;
+    order.order_id = pending_order.order_id;
+    order.trader_id = pending_order.trader_id;
+    order.price = pending_order.price;
+    order.quantity = pending_order.quantity;
+    order.side = pending_order.side;
+    order.type = pending_order.type;
+    order.timestamp = simulation_time;
+
+    book(instrument).pending_orders.push_back(order);
+}
+
+// Route a market order to its instrument's pending buffer
+void MultiBookSimulator::place_market_order(InstrumentID instrument, const PendingMarketOrder& pending_market_order) {
+    Order order;
+    order.order_id = pending_market_order.order_id;
+    order.trader_id = pending_market_order.trader_id;
+    order.price = 0.0; // Price is irrelevant for market orders
+    order.quantity = pending_market_order.quantity;
+    order.side = pending_market_order.side;
+    order.type = OrderType::MARKET;
+    order.timestamp = simulation_time;
+
+    book(instrument).pending_orders.push_back(order);
+}
+
+void MultiBookSimulator::cancel_order(InstrumentID instrument, OrderID order_id) {
+    book(instrument).order_book.cancel_order(order_id);
+}
+
+void MultiBookSimulator::modify_order(InstrumentID instrument, OrderID order_id, Price new_price, Quantity new_quantity) {
+    book(instrument).order_book.modify_order(order_id, new_price, new_quantity);
+}
+
+// Match all books in parallel, each worker owns the books i with i % workers == worker
+void MultiBookSimulator::submit_pending_orders() {
+    std::size_t workers = pool.size();
+    pool.run([this, workers](std::size_t worker) {
+        for (std::size_t i = worker; i < books.size(); i += workers) {
+            Book& b = *books[i];
+            for (const Order& order : b.pending_orders) {
+                if (order.type == OrderType::MARKET) {
+                    b.order_book.place_market_order(order);
+                } else {
+                    b.order_book.place_limit_order(order);
+                }
+            }
+            b.pending_orders.clear();
+        }
+    });
+
+    for (std::size_t i = 0; i < books.size(); ++i) {
+        auto instrument = static_cast<InstrumentID>(i);
+        record_runs(trade_runs, trade_marks, instrument, books[i]->sink->trade_sequence());
+        record_runs(order_log_runs, order_log_marks, instrument, books[i]->sink->order_log_sequence());
+    }
+}
+
+void MultiBookSimulator::record_runs(std::vector<JournalRun>& runs, std::vector<std::uint64_t>& marks,
+                                     InstrumentID instrument, std::uint64_t sequence) {
+    if (sequence > marks[instrument]) {
+        runs.push_back(JournalRun{instrument, sequence});
+        marks[instrument] = sequence;
+    }
+}
+
+Level1Data MultiBookSimulator::get_level1_data(InstrumentID instrument) const {
+    return book(instrument).order_book.get_level1_data();
+}
+
+Level2Data MultiBookSimulator::get_level2_data(InstrumentID instrument) const {
+    return book(instrument).order_book.get_level2_data();
+}
+
+std::vector<Level1Data> MultiBookSimulator::get_all_level1_data() const {
+    std::vector<Level1Data> data;
+    data.reserve(books.size());
+    for (const auto& b : books) {
+        data.push_back(b->order_book.get_level1_data());
+    }
+    return data;
+}
+
+template <typename T, typename Journal>
+std::vector<std::pair<InstrumentID, T>> MultiBookSimulator::merge(const std::vector<JournalRun>& runs, Journal journal) const {
+    std::size_t n = books.size();
+    std::vector<std::pair<InstrumentID, T>> merged;
+    std::vector<std::uint64_t> cursor(n, 0);
+
+    auto take = [&](std::size_t i, std::uint64_t end) {
+        const auto& records = journal(*books[i]);
+        for (; cursor[i] < end; ++cursor[i]) {
+            merged.emplace_back(static_cast<InstrumentID>(i), records[cursor[i]]);
+        }
+    };
+
+    // Every submit step, then whatever was logged since the last one (cancels, modifies)
+    for (const JournalRun& run : runs) {
+        take(run.instrument, run.end);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        take(i, journal(*books[i]).size());
+    }
+    return merged;
+}
+
+std::vector<std::pair<InstrumentID, Trade>> MultiBookSimulator::get_trade_logs() const {
+    return merge<Trade>(trade_runs, [](const Book& b) -> const EventJournal<Trade>& { return b.sink->trade_logs; });
+}
+
+std::vector<std::pair<InstrumentID, OrderLog>> MultiBookSimulator::get_order_logs() const {
+    return merge<OrderLog>(order_log_runs, [](const Book& b) -> const EventJournal<OrderLog>& { return b.sink->order_logs; });
+}
+
+std::vector<Trade> MultiBookSimulator::get_book_trade_logs(InstrumentID instrument) const {
+    return book(instrument).sink->retained_trades();
+}
+
+std::vector<OrderLog> MultiBookSimulator::get_book_order_logs(InstrumentID instrument) const {
+    return book(instrument).sink->retained_order_logs();
+}
+
+void MultiBookSimulator::advance_time(Timestamp dt) {
+    simulation_time += dt;
+    for (const auto& b : books) {
+        b->order_book.advance_time(simulation_time);
+    }
+}
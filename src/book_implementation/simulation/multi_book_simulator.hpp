@@ -0,0 +1,108 @@
+#pragma once
+#include "simulator.hpp"
+#include "thread_pool.hpp"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+// =============================================
+// Multi-Book Simulator
+// =============================================
+
+using InstrumentID = std::uint32_t;
+
+// Settings shared by every book of a MultiBookSimulator
+struct MultiBookConfig {
+    std::size_t num_books = 1;
+    std::size_t num_threads = 0;                 // 0 = one per hardware thread
+    std::optional<LadderConfig> ladder;          // Tick ladder books when set
+    InvariantMode invariant_mode = ORDER_BOOK_DEFAULT_INVARIANT_MODE;
+};
+
+/**
+ * N independent order books (one per instrument) advanced in parallel.
+ *
+ * Orders are routed by instrument id into that book's pending buffer. submit_pending_orders()
+ * then matches every book at once: book i is always handled by worker i % num_threads, so a
+ * book stays on one thread and books never share state. Each book logs into its own
+ * MemorySink; at the end of every submit, each book that logged something since the last
+ * submit gets a run (instrument, sequence reached) appended in instrument order, and the
+ * merged event streams are rebuilt from those runs. Steps without events cost nothing, and
+ * the merged order is the same for any thread count.
+ */
+class MultiBookSimulator {
+    private:
+        struct Book {
+            std::shared_ptr<MemorySink> sink = std::make_shared<MemorySink>();
+            OrderBook order_book;
+            std::vector<Order> pending_orders;
+
+            explicit Book(const MultiBookConfig& config)
+                : order_book(config.ladder ? OrderBook(*config.ladder, sink) : OrderBook(sink)) {
+                order_book.set_invariant_mode(config.invariant_mode);
+            }
+        };
+
+        MultiBookConfig config;
+        std::vector<std::unique_ptr<Book>> books;
+        ThreadPool pool;
+        Timestamp simulation_time = 0;
+
+        // Events of `instrument` up to sequence `end`, the next stretch of the merged stream
+        struct JournalRun {
+            InstrumentID instrument;
+            std::uint64_t end;
+        };
+
+        std::vector<JournalRun> trade_runs;
+        std::vector<JournalRun> order_log_runs;
+        // Per-book sequence already covered by a run
+        std::vector<std::uint64_t> trade_marks;
+        std::vector<std::uint64_t> order_log_marks;
+
+        Book& book(InstrumentID instrument);
+        const Book& book(InstrumentID instrument) const;
+
+        // Append a run for every book whose journal moved past its mark
+        static void record_runs(std::vector<JournalRun>& runs, std::vector<std::uint64_t>& marks,
+                                InstrumentID instrument, std::uint64_t sequence);
+        // Merge the per-book journals run by run, then whatever was logged after the last submit
+        template <typename T, typename Journal>
+        std::vector<std::pair<InstrumentID, T>> merge(const std::vector<JournalRun>& runs, Journal journal) const;
+
+    public:
+        MultiBookSimulator(const MultiBookConfig& config, Timestamp start_time = 0);
+
+        std::size_t get_num_books() const { return books.size(); }
+        std::size_t get_num_threads() const { return pool.size(); }
+
+        // Queue orders for one instrument, matched at the next submit_pending_orders()
+        void place_limit_order(InstrumentID instrument, const PendingOrder& pending_order);
+        void place_market_order(InstrumentID instrument, const PendingMarketOrder& pending_market_order);
+
+        // Applied to the book immediately
+        void cancel_order(InstrumentID instrument, OrderID order_id);
+        void modify_order(InstrumentID instrument, OrderID order_id, Price new_price, Quantity new_quantity);
+
+        // Match every book's pending orders (FIFO per book) in parallel
+        void submit_pending_orders();
+
+        // Market data of one instrument
+        Level1Data get_level1_data(InstrumentID instrument) const;
+        Level2Data get_level2_data(InstrumentID instrument) const;
+        // Top of book of every instrument, indexed by instrument id
+        std::vector<Level1Data> get_all_level1_data() const;
+
+        // Event streams of all books merged deterministically, each tagged with its instrument
+        std::vector<std::pair<InstrumentID, Trade>> get_trade_logs() const;
+        std::vector<std::pair<InstrumentID, OrderLog>> get_order_logs() const;
+        // Event stream of one book
+        std::vector<Trade> get_book_trade_logs(InstrumentID instrument) const;
+        std::vector<OrderLog> get_book_order_logs(InstrumentID instrument) const;
+
+        // Advance the simulation time of every book
+        void advance_time(Timestamp dt);
+        Timestamp get_current_time() const { return simulation_time; }
+};
@@ -1,11 +1,171 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/numpy.h>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <optional>
 #include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
 #include "simulator.hpp"
+#include "multi_book_simulator.hpp"
+#include "batch_runner.hpp"
+#include "agents/random_agent.hpp"
+#include "agents/market_maker_agent.hpp"
 #include "../order_book/types.hpp"
+#include "../order_book/journal_file.hpp"
+#include "../order_book/matching_engine.hpp"
 
 namespace py = pybind11;
 
+// ============================================================================
+// NumPy helpers
+// =============================================================================
+
+// (field name, numpy format, byte offset inside the record)
+using DtypeField = std::tuple<const char*, const char*, std::size_t>;
+
+// Build a structured dtype that matches a C++ record layout exactly (including padding)
+static py::dtype make_dtype(const std::vector<DtypeField>& fields, std::size_t itemsize) {
+     py::list names, formats, offsets;
+     for (const auto& [name, format, offset] : fields) {
+          names.append(name);
+          formats.append(format);
+          offsets.append(offset);
+     }
+     py::dict spec;
+     spec["names"] = names;
+     spec["formats"] = formats;
+     spec["offsets"] = offsets;
+     spec["itemsize"] = itemsize;
+     return py::dtype::from_args(spec);
+}
+
+// Fields of a Trade stored `base` bytes into a record
+static std::vector<DtypeField> trade_fields(std::size_t base) {
+     return {
+          {"trade_id", "u8", base + offsetof(Trade, trade_id)},
+          {"buy_order_id", "u8", base + offsetof(Trade, buy_order_id)},
+          {"sell_order_id", "u8", base + offsetof(Trade, sell_order_id)},
+          {"aggressor_side", "u1", base + offsetof(Trade, aggressor_side)},
+          {"buyer_id", "u8", base + offsetof(Trade, buyer_id)},
+          {"seller_id", "u8", base + offsetof(Trade, seller_id)},
+          {"price", "f8", base + offsetof(Trade, price)},
+          {"quantity", "u4", base + offsetof(Trade, quantity)},
+          {"timestamp", "u8", base + offsetof(Trade, timestamp)},
+     };
+}
+
+// Fields of an OrderLog stored `base` bytes into a record
+static std::vector<DtypeField> order_log_fields(std::size_t base) {
+     return {
+          {"order_id", "u8", base + offsetof(OrderLog, order_id)},
+          {"trader_id", "u8", base + offsetof(OrderLog, trader_id)},
+          {"price", "f8", base + offsetof(OrderLog, price)},
+          {"quantity", "u4", base + offsetof(OrderLog, quantity)},
+          {"side", "u1", base + offsetof(OrderLog, side)},
+          {"type", "u1", base + offsetof(OrderLog, type)},
+          {"status", "u1", base + offsetof(OrderLog, status)},
+          {"event", "u1", base + offsetof(OrderLog, event)},
+          {"timestamp", "u8", base + offsetof(OrderLog, timestamp)},
+     };
+}
+
+// Fields of a PriceLevel record
+static std::vector<DtypeField> price_level_fields() {
+     return {
+          {"price", "f8", offsetof(PriceLevel, price)},
+          {"total_quantity", "u4", offsetof(PriceLevel, total_quantity)},
+          {"order_count", "u4", offsetof(PriceLevel, order_count)},
+     };
+}
+
+// Caller-owned PriceLevel records filled in place: writeable, contiguous, 1-D, exactly `dtype`
+static PriceLevel* level_buffer(py::array& buffer, const py::dtype& dtype, const char* name) {
+     if (buffer.ndim() != 1 || !buffer.dtype().equal(dtype)) {
+          throw py::value_error(std::string(name) + " must be a 1-D array of price_level_dtype");
+     }
+     if (!buffer.writeable() || !(buffer.flags() & py::array::c_style)) {
+          throw py::value_error(std::string(name) + " must be writeable and contiguous");
+     }
+     return static_cast<PriceLevel*>(buffer.mutable_data());
+}
+
+// Journal record = sequence number followed by the payload record
+template <typename Record>
+static py::dtype journal_dtype(std::vector<DtypeField> payload_fields) {
+     payload_fields.insert(payload_fields.begin(), DtypeField{"sequence", "u8", offsetof(Record, sequence)});
+     return make_dtype(payload_fields, sizeof(Record));
+}
+
+// Read-only array over `count` records at `data` without copying, `owner` keeps the memory alive
+static py::array record_view(const py::dtype& dtype, const void* data, std::size_t count, std::size_t stride, py::handle owner) {
+     py::array view(dtype,
+                    std::vector<py::ssize_t>{static_cast<py::ssize_t>(count)},
+                    std::vector<py::ssize_t>{static_cast<py::ssize_t>(stride)},
+                    data, owner);
+     view.attr("flags").attr("writeable") = false;
+     return view;
+}
+
+// Sink records with sequence >= since: a zero-copy view when the sink keeps them in a single
+// stable span, otherwise one memcpy per span into a fresh array (no per-record Python objects)
+template <typename T, typename Visit>
+static py::array sink_records(const py::dtype& dtype, bool stable, py::handle owner, Visit&& visit) {
+     std::vector<std::pair<const T*, std::size_t>> spans;
+     std::size_t total = 0;
+     visit([&](const T* records, std::size_t count) {
+          spans.emplace_back(records, count);
+          total += count;
+     });
+     if (stable && spans.size() == 1) {
+          return record_view(dtype, spans[0].first, spans[0].second, sizeof(T), owner);
+     }
+
+     py::array out(dtype, std::vector<py::ssize_t>{static_cast<py::ssize_t>(total)});
+     auto* dest = static_cast<unsigned char*>(out.mutable_data());
+     for (const auto& [records, count] : spans) {
+          std::memcpy(dest, records, count * sizeof(T));
+          dest += count * sizeof(T);
+     }
+     return out;
+}
+
+// Fields of a ReplicaStats record
+static std::vector<DtypeField> replica_stats_fields() {
+     return {
+          {"seed", "u8", offsetof(ReplicaStats, seed)},
+          {"trade_count", "u8", offsetof(ReplicaStats, trade_count)},
+          {"volume", "u8", offsetof(ReplicaStats, volume)},
+          {"vwap", "f8", offsetof(ReplicaStats, vwap)},
+          {"spread_samples", "u8", offsetof(ReplicaStats, spread_samples)},
+          {"spread_mean", "f8", offsetof(ReplicaStats, spread_mean)},
+          {"spread_std", "f8", offsetof(ReplicaStats, spread_std)},
+          {"spread_p5", "f8", offsetof(ReplicaStats, spread_p5)},
+          {"spread_p50", "f8", offsetof(ReplicaStats, spread_p50)},
+          {"spread_p95", "f8", offsetof(ReplicaStats, spread_p95)},
+          {"final_mid", "f8", offsetof(ReplicaStats, final_mid)},
+          {"final_inventory", "i8", offsetof(ReplicaStats, final_inventory)},
+          {"final_cash", "f8", offsetof(ReplicaStats, final_cash)},
+     };
+}
+
+// Columns of a batch submission, converted (only if needed) to contiguous arrays of the C++ type
+template <typename T>
+using Column = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+static std::size_t batch_size(std::initializer_list<py::ssize_t> sizes) {
+     py::ssize_t count = *sizes.begin();
+     for (py::ssize_t size : sizes) {
+          if (size != count) {
+               throw py::value_error("Batch columns must all have the same length");
+          }
+     }
+     return static_cast<std::size_t>(count);
+}
+
 // ============================================================================
 // Python Bindings
 // =============================================================================
@@ -26,9 +186,12 @@ PYBIND11_MODULE(market_simulator, m) {
 
      // Expose the OrderType enum
      // This allows using market_simulator.OrderType.LIMIT in Python
-     py::enum_<OrderType>(m, "OrderType", "Enumeration for order type (limit or market)")
+     py::enum_<OrderType>(m, "OrderType", "Enumeration for order type")
          .value("LIMIT", OrderType::LIMIT, "Limit order")
          .value("MARKET", OrderType::MARKET, "Market order")
+         .value("IOC", OrderType::IOC, "Immediate-or-cancel: trade what crosses now, cancel the rest")
+         .value("FOK", OrderType::FOK, "Fill-or-kill: trade the whole quantity now or nothing")
+         .value("POST_ONLY", OrderType::POST_ONLY, "Rest without trading, rejected if it would cross")
          .export_values();
 
      // Expose the OrderStatus enum
@@ -41,6 +204,60 @@ PYBIND11_MODULE(market_simulator, m) {
           .value("CANCELED", OrderStatus::CANCELED, "Order has been canceled")
           .export_values();
 
+     // Expose the OrderEvent enum
+     // This allows using market_simulator.OrderEvent.TRADE_EXECUTED in Python
+     py::enum_<OrderEvent>(m, "OrderEvent", "Enumeration for order log events")
+          .value("LIMIT_PLACED", OrderEvent::LIMIT_PLACED, "Limit order rested in the book")
+          .value("TRADE_EXECUTED", OrderEvent::TRADE_EXECUTED, "Fill of a limit order")
+          .value("MARKET_EXECUTED", OrderEvent::MARKET_EXECUTED, "Market order executed")
+          .value("NO_LIQUIDITY", OrderEvent::NO_LIQUIDITY, "Market order hit an empty book side")
+          .value("CANCELED", OrderEvent::CANCELED, "Resting order canceled")
+          .value("MODIFIED", OrderEvent::MODIFIED, "Resting order modified")
+          .value("PRICE_OUT_OF_BAND", OrderEvent::PRICE_OUT_OF_BAND, "Limit price outside the tick ladder band")
+          .value("REMAINDER_CANCELED", OrderEvent::REMAINDER_CANCELED, "Untraded rest of an IOC order canceled")
+          .value("FOK_REJECTED", OrderEvent::FOK_REJECTED, "Not enough liquidity for a FOK order, nothing traded")
+          .value("POST_ONLY_REJECTED", OrderEvent::POST_ONLY_REJECTED, "Post-only order would have crossed the spread")
+          .export_values();
+
+     // Expose the InvariantMode enum
+     // This allows using market_simulator.InvariantMode.SAMPLED in Python
+     py::enum_<InvariantMode>(m, "InvariantMode", "How much book validation runs after each order")
+          .value("OFF", InvariantMode::OFF, "No checks")
+          .value("CHEAP", InvariantMode::CHEAP, "Best bid < best ask check after every order")
+          .value("SAMPLED", InvariantMode::SAMPLED, "Full scan every N order events")
+          .value("FULL", InvariantMode::FULL, "Full scan after every order")
+          .export_values();
+
+     // Expose the EngineOp enum
+     // This allows using market_simulator.EngineOp.CANCEL in Python
+     py::enum_<EngineOp>(m, "EngineOp", "Instrumented order book operation")
+          .value("PLACE_LIMIT", EngineOp::PLACE_LIMIT, "place_limit_order")
+          .value("PLACE_MARKET", EngineOp::PLACE_MARKET, "place_market_order")
+          .value("CANCEL", EngineOp::CANCEL, "cancel_order")
+          .value("MODIFY", EngineOp::MODIFY, "modify_order")
+          .value("SNAPSHOT", EngineOp::SNAPSHOT, "get_snapshot")
+          .value("LEVEL1", EngineOp::LEVEL1, "get_level1_data")
+          .value("LEVEL2", EngineOp::LEVEL2, "get_level2_data and the bounded depth copies")
+          .export_values();
+
+     // Expose the SubmitStatus enum
+     // Batch submission returns these as raw uint8 codes, e.g. status == SubmitStatus.ACCEPTED.value
+     py::enum_<SubmitStatus>(m, "SubmitStatus", "Per-order result of a batch submission")
+          .value("ACCEPTED", SubmitStatus::ACCEPTED, "Order queued")
+          .value("INVALID_QUANTITY", SubmitStatus::INVALID_QUANTITY, "Rejected: zero quantity")
+          .value("INVALID_PRICE", SubmitStatus::INVALID_PRICE, "Rejected: limit price is not a positive finite number")
+          .value("INVALID_SIDE", SubmitStatus::INVALID_SIDE, "Rejected: side code is neither BUY (0) nor SELL (1)")
+          .value("INVALID_TYPE", SubmitStatus::INVALID_TYPE, "Rejected: unknown OrderType code, or MARKET where a limit order is expected")
+          .export_values();
+
+     // Expose the SequencingPolicy enum
+     // This allows using market_simulator.SequencingPolicy.SHUFFLE in Python
+     py::enum_<SequencingPolicy>(m, "SequencingPolicy", "Order in which pending orders reach the book")
+          .value("FIFO", SequencingPolicy::FIFO, "Arrival order")
+          .value("SHUFFLE", SequencingPolicy::SHUFFLE, "Seeded random permutation")
+          .value("LATENCY", SequencingPolicy::LATENCY, "Per-trader latency plus seeded random jitter")
+          .export_values();
+
      // =============================================
      // Structures
      // =============================================
@@ -279,15 +496,43 @@ PYBIND11_MODULE(market_simulator, m) {
           ))
           ;
 
+     // Expose the LadderConfig structure for the tick ladder book mode
+     py::class_<LadderConfig>(m, "LadderConfig", "Tick size and price band for a tick ladder order book")
+          .def(py::init([](Price tick_size, Price min_price, Price max_price) {
+                    return LadderConfig{tick_size, min_price, max_price};
+               }),
+               py::arg("tick_size") = 0.01, py::arg("min_price") = 0.01, py::arg("max_price") = 1000.0)
+          .def_readwrite("tick_size", &LadderConfig::tick_size, "Minimum price increment")
+          .def_readwrite("min_price", &LadderConfig::min_price, "Lowest price accepted by the book")
+          .def_readwrite("max_price", &LadderConfig::max_price, "Highest price accepted by the book")
+          .def("__repr__", [](const LadderConfig &x) {
+               return "<LadderConfig tick_size=" + std::to_string(x.tick_size) + ">";
+          })
+          .def("to_dict", [](const LadderConfig &x) {
+               py::dict d;
+               d["tick_size"] = x.tick_size;
+               d["min_price"] = x.min_price;
+               d["max_price"] = x.max_price;
+               return d;
+          })
+          ;
+
      // Expose the PendingOrder structure
      py::class_<PendingOrder>(m, "PendingOrder", "Structure representing a pending order")
-          .def(py::init<OrderID, TraderID, Price, Quantity, OrderSide>(),
-               py::arg("order_id"), py::arg("trader_id"), py::arg("price"), py::arg("quantity"), py::arg("side"))
+          .def(py::init([](OrderID order_id, TraderID trader_id, Price price, Quantity quantity, OrderSide side, OrderType type) {
+                    if (type == OrderType::MARKET) {
+                         throw py::value_error("PendingOrder needs a limit-priced type, use PendingMarketOrder for market orders");
+                    }
+                    return PendingOrder{order_id, trader_id, price, quantity, side, type};
+               }),
+               py::arg("order_id"), py::arg("trader_id"), py::arg("price"), py::arg("quantity"), py::arg("side"),
+               py::arg("type") = OrderType::LIMIT)
           .def_readonly("order_id", &PendingOrder::order_id, "Unique identifier for the order")
           .def_readonly("trader_id", &PendingOrder::trader_id, "Identifier of the trader placing the order")
           .def_readonly("price", &PendingOrder::price, "Limit price for the order")
           .def_readonly("quantity", &PendingOrder::quantity, "Number of shares/contracts")
           .def_readonly("side", &PendingOrder::side, "Order side (BUY or SELL)")
+          .def_readonly("type", &PendingOrder::type, "LIMIT, IOC, FOK or POST_ONLY")
           .def("__repr__", [](const PendingOrder &x) {
               return "<PendingOrder order_id=" + std::to_string(x.order_id) + ">";
           })
@@ -298,14 +543,16 @@ PYBIND11_MODULE(market_simulator, m) {
                d["price"] = x.price;
                d["quantity"] = x.quantity;
                d["side"] = x.side;
+               d["type"] = x.type;
                return d;
           })
           .def(py::pickle(
                [](const PendingOrder &x) {
-                    return py::make_tuple(x.order_id, x.trader_id, x.price, x.quantity, x.side);
+                    return py::make_tuple(x.order_id, x.trader_id, x.price, x.quantity, x.side, x.type);
                },
                [](py::tuple t) {
-                    if (t.size() != 5) {
+                    // 5-tuples come from before PendingOrder had a type
+                    if (t.size() != 5 && t.size() != 6) {
                          throw std::runtime_error("Invalid state for PendingOrder");
                     }
                     PendingOrder x;
@@ -314,6 +561,7 @@ PYBIND11_MODULE(market_simulator, m) {
                     x.price = t[2].cast<Price>();
                     x.quantity = t[3].cast<Quantity>();
                     x.side = t[4].cast<OrderSide>();
+                    x.type = t.size() == 6 ? t[5].cast<OrderType>() : OrderType::LIMIT;
                     return x;
                }
           ))
@@ -366,9 +614,13 @@ PYBIND11_MODULE(market_simulator, m) {
           .def_readonly("type", &OrderLog::type, "Order type (LIMIT or MARKET)")
           .def_readonly("status", &OrderLog::status, "Current status of the order")
           .def_readonly("timestamp", &OrderLog::timestamp, "Timestamp of the order event")
-          .def_readonly("details", &OrderLog::details, "Additional details about the order event")
+          .def_readonly("event", &OrderLog::event, "Event code of the order event")
+          // Rendered from the event code on access, the log record itself holds no string
+          .def_property_readonly("details", [](const OrderLog &x) {
+               return std::string(order_event_details(x));
+          }, "Additional details about the order event")
           .def("__repr__", [](const OrderLog &x) {
-              return "<OrderLog order_id=" + std::to_string(x.order_id) + ">";
+              return "<OrderLog order_id=" + std::to_string(x.order_id) + " details='" + order_event_details(x) + "'>";
           })
           .def("to_dict", [](const OrderLog &x) {
                py::dict d;
@@ -380,7 +632,8 @@ PYBIND11_MODULE(market_simulator, m) {
                d["type"] = x.type;
                d["status"] = x.status;
                d["timestamp"] = x.timestamp;
-               d["details"] = x.details;
+               d["event"] = x.event;
+               d["details"] = std::string(order_event_details(x));
                return d;
           })
           .def(py::pickle(
@@ -394,7 +647,7 @@ PYBIND11_MODULE(market_simulator, m) {
                          x.type,
                          x.status,
                          x.timestamp,
-                         x.details
+                         x.event
                     );
                },
                [](py::tuple t) {
@@ -410,7 +663,7 @@ PYBIND11_MODULE(market_simulator, m) {
                     x.type = t[5].cast<OrderType>();
                     x.status = t[6].cast<OrderStatus>();
                     x.timestamp = t[7].cast<Timestamp>();
-                    x.details = t[8].cast<std::string>();
+                    x.event = t[8].cast<OrderEvent>();
                     return x;
                }
           ))
@@ -508,6 +761,88 @@ PYBIND11_MODULE(market_simulator, m) {
           ))
           ;
 
+     // Record layout of PriceLevel, for preallocated depth buffers
+     py::dtype price_level_dtype = make_dtype(price_level_fields(), sizeof(PriceLevel));
+     m.attr("price_level_dtype") = price_level_dtype;
+
+     // Expose the Level 2 delta structures
+     py::class_<LevelUpdate>(m, "LevelUpdate", "New state of one changed price level")
+          .def_readonly("sequence", &LevelUpdate::sequence, "Sequence number of the change")
+          .def_readonly("timestamp", &LevelUpdate::timestamp, "Book time of the change")
+          .def_readonly("price", &LevelUpdate::price, "Price of the level")
+          .def_readonly("total_quantity", &LevelUpdate::total_quantity, "New total quantity, 0 = level removed")
+          .def_readonly("order_count", &LevelUpdate::order_count, "New number of orders at the level")
+          .def_readonly("side", &LevelUpdate::side, "Side of the level")
+          .def("__repr__", [](const LevelUpdate &x) {
+               return "<LevelUpdate sequence=" + std::to_string(x.sequence) + " price=" + std::to_string(x.price) +
+                      " quantity=" + std::to_string(x.total_quantity) + ">";
+          })
+          .def("to_dict", [](const LevelUpdate &x) {
+               py::dict d;
+               d["sequence"] = x.sequence;
+               d["timestamp"] = x.timestamp;
+               d["price"] = x.price;
+               d["total_quantity"] = x.total_quantity;
+               d["order_count"] = x.order_count;
+               d["side"] = x.side;
+               return d;
+          })
+          ;
+
+     py::class_<Level2Updates>(m, "Level2Updates", "Level 2 changes since a sequence, or a full snapshot to resync from")
+          .def_readonly("sequence", &Level2Updates::sequence, "Last change covered, pass it as since_sequence next time")
+          .def_readonly("is_snapshot", &Level2Updates::is_snapshot, "True if snapshot replaces the caller's book")
+          .def_readonly("snapshot", &Level2Updates::snapshot, "Full depth (only when is_snapshot)")
+          .def_readonly("updates", &Level2Updates::updates, "Changed levels oldest first (only when not is_snapshot)")
+          .def("__repr__", [](const Level2Updates &x) {
+               return "<Level2Updates sequence=" + std::to_string(x.sequence) +
+                      (x.is_snapshot ? " snapshot>" : " updates=" + std::to_string(x.updates.size()) + ">");
+          })
+          ;
+
+     py::class_<DistributionSummary>(m, "DistributionSummary", "Count, mean and percentiles of one recorded distribution")
+          .def_readonly("count", &DistributionSummary::count, "Number of samples")
+          .def_readonly("min", &DistributionSummary::min, "Smallest sample")
+          .def_readonly("mean", &DistributionSummary::mean, "Mean sample")
+          .def_readonly("p50", &DistributionSummary::p50, "Median")
+          .def_readonly("p90", &DistributionSummary::p90, "90th percentile")
+          .def_readonly("p99", &DistributionSummary::p99, "99th percentile")
+          .def_readonly("p999", &DistributionSummary::p999, "99.9th percentile")
+          .def_readonly("max", &DistributionSummary::max, "Largest sample")
+          .def("to_dict", [](const DistributionSummary &x) {
+               py::dict d;
+               d["count"] = x.count;
+               d["min"] = x.min;
+               d["mean"] = x.mean;
+               d["p50"] = x.p50;
+               d["p90"] = x.p90;
+               d["p99"] = x.p99;
+               d["p999"] = x.p999;
+               d["max"] = x.max;
+               return d;
+          })
+          ;
+
+     py::class_<OperationStats>(m, "OperationStats", "Instrumentation of one order book operation")
+          .def_readonly("operation", &OperationStats::operation, "Operation the counters belong to")
+          .def_readonly("ticks", &OperationStats::ticks, "TSC ticks from entry to exit (divide by EngineStats.ticks_per_ns for ns)")
+          .def_readonly("fills", &OperationStats::fills, "Trades per call")
+          .def_readonly("levels_walked", &OperationStats::levels_walked, "Distinct resting levels traded against per call")
+          .def_readonly("allocating_calls", &OperationStats::allocating_calls, "Calls that grew the book's order, index or level storage")
+          .def("__repr__", [](const OperationStats &x) {
+               return std::string("<OperationStats ") + engine_op_name(x.operation) + " count=" + std::to_string(x.ticks.count) + ">";
+          })
+          ;
+
+     py::class_<EngineStats>(m, "EngineStats", "Per-operation latency and work counters of an order book")
+          .def_readonly("enabled", &EngineStats::enabled, "False unless the module was built with ORDER_BOOK_ENGINE_STATS=1")
+          .def_readonly("ticks_per_ns", &EngineStats::ticks_per_ns, "TSC ticks per nanosecond")
+          .def_readonly("operations", &EngineStats::operations, "One entry per EngineOp, in enum order")
+          .def("__repr__", [](const EngineStats &x) {
+               return std::string("<EngineStats enabled=") + (x.enabled ? "True" : "False") + ">";
+          })
+          ;
+
      // Expose the Order structure
      py::class_<Order>(m, "Order", "Structure representing an order in the order book")
           .def_readonly("order_id", &Order::order_id, "Unique identifier for the order")
@@ -561,6 +896,135 @@ PYBIND11_MODULE(market_simulator, m) {
           ;
 
 
+     // =============================================
+     // Event Sinks
+     // =============================================
+
+     // Base class, only used as the type of the Simulator's sink argument
+     py::class_<EventSink, std::shared_ptr<EventSink>>(m, "EventSink", "Destination for trade and order events");
+
+     py::class_<NullSink, EventSink, std::shared_ptr<NullSink>>(m, "NullSink", "Event sink that drops every event")
+          .def(py::init<>());
+
+     py::class_<MemorySink, EventSink, std::shared_ptr<MemorySink>>(m, "MemorySink", "Event sink that keeps every event in memory")
+          .def(py::init<>());
+
+     py::class_<RingSink, EventSink, std::shared_ptr<RingSink>>(m, "RingSink", "Event sink that keeps the most recent N events")
+          .def(py::init<std::size_t, std::size_t>(),
+               py::arg("trade_capacity"), py::arg("order_log_capacity"));
+
+     py::class_<BinaryFileSink, EventSink, std::shared_ptr<BinaryFileSink>>(m, "BinaryFileSink", "Event sink that streams records to binary files")
+          .def(py::init<const std::string&, const std::string&>(),
+               py::arg("trade_path"), py::arg("order_path"));
+
+     // Python callables are invoked with the GIL held, whichever thread runs the matching
+     py::class_<CallbackSink, EventSink, std::shared_ptr<CallbackSink>>(m, "CallbackSink", "Event sink that forwards events to Python callables")
+          .def(py::init([](py::object on_trade, py::object on_order_event) {
+                    auto sink = std::make_shared<CallbackSink>();
+                    if (!on_trade.is_none()) {
+                         sink->trade_callback = [on_trade](const Trade &trade) {
+                              py::gil_scoped_acquire gil;
+                              on_trade(trade);
+                         };
+                    }
+                    if (!on_order_event.is_none()) {
+                         sink->order_event_callback = [on_order_event](const OrderLog &log) {
+                              py::gil_scoped_acquire gil;
+                              on_order_event(log);
+                         };
+                    }
+                    return sink;
+               }),
+               py::arg("on_trade") = py::none(), py::arg("on_order_event") = py::none());
+
+     // =============================================
+     // Journal Readers
+     // =============================================
+
+     // Memory-mapped readers for the files written by BinaryFileSink
+     // to_numpy() returns a zero-copy structured array that keeps the mapping alive
+     py::class_<JournalReader<TradeRecord>>(m, "TradeJournal", "Memory-mapped trade journal file")
+          .def(py::init<const std::string&>(), py::arg("path"))
+          .def("__len__", &JournalReader<TradeRecord>::size)
+          .def("__getitem__", [](const JournalReader<TradeRecord> &journal, std::size_t index) {
+               if (index >= journal.size()) {
+                    throw py::index_error("Trade journal index out of range");
+               }
+               return journal[index].trade;
+          })
+          .def("to_numpy", [](py::object self) {
+               const auto &journal = self.cast<const JournalReader<TradeRecord>&>();
+               return record_view(journal_dtype<TradeRecord>(trade_fields(offsetof(TradeRecord, trade))),
+                                  journal.data(), journal.size(), sizeof(TradeRecord), self);
+          }, "Zero-copy NumPy structured array over all records (sequence + trade fields)")
+          .def("__repr__", [](const JournalReader<TradeRecord> &journal) {
+               return "<TradeJournal records=" + std::to_string(journal.size()) + ">";
+          });
+
+     py::class_<JournalReader<OrderLogRecord>>(m, "OrderJournal", "Memory-mapped order event journal file")
+          .def(py::init<const std::string&>(), py::arg("path"))
+          .def("__len__", &JournalReader<OrderLogRecord>::size)
+          .def("__getitem__", [](const JournalReader<OrderLogRecord> &journal, std::size_t index) {
+               if (index >= journal.size()) {
+                    throw py::index_error("Order journal index out of range");
+               }
+               return journal[index].log;
+          })
+          .def("to_numpy", [](py::object self) {
+               const auto &journal = self.cast<const JournalReader<OrderLogRecord>&>();
+               return record_view(journal_dtype<OrderLogRecord>(order_log_fields(offsetof(OrderLogRecord, log))),
+                                  journal.data(), journal.size(), sizeof(OrderLogRecord), self);
+          }, "Zero-copy NumPy structured array over all records (sequence + order log fields)")
+          .def("__repr__", [](const JournalReader<OrderLogRecord> &journal) {
+               return "<OrderJournal records=" + std::to_string(journal.size()) + ">";
+          });
+
+     // =============================================
+     // Native Agents
+     // =============================================
+
+     // Base class, only used as the type of Simulator.add_agent's argument
+     py::class_<Agent, std::shared_ptr<Agent>>(m, "Agent", "Native trading agent driven by Simulator.run")
+          .def_property_readonly("trader_id", &Agent::get_trader_id, "Identifier of the trader");
+
+     py::class_<RandomAgent, Agent, std::shared_ptr<RandomAgent>>(m, "RandomAgent", "Native agent placing random limit orders around the mid price")
+          .def(py::init<TraderID, OrderID, OrderID, std::uint64_t, double, Price>(),
+               py::arg("trader_id"), py::arg("first_order_id"), py::arg("last_order_id"),
+               py::arg("seed") = 0, py::arg("trading_probability") = 0.35, py::arg("min_price") = 0.01,
+               "Create a random agent\n\n"
+               "Args:\n"
+               "    trader_id (int): Identifier of the trader\n"
+               "    first_order_id (int): First order id of the agent's id range\n"
+               "    last_order_id (int): End (exclusive) of the agent's id range\n"
+               "    seed (int, optional): Seed of the agent's random generator\n"
+               "    trading_probability (float, optional): Chance to trade each tick\n"
+               "    min_price (float, optional): Lowest price the agent will quote")
+          .def("__repr__", [](const RandomAgent &x) {
+               return "<RandomAgent trader_id=" + std::to_string(x.get_trader_id()) + ">";
+          });
+
+     py::class_<MarketMakerAgent, Agent, std::shared_ptr<MarketMakerAgent>>(m, "MarketMakerAgent", "Native agent quoting both sides around the mid price")
+          .def(py::init<TraderID, OrderID, OrderID, Price, Quantity, std::int64_t, Price, Price>(),
+               py::arg("trader_id"), py::arg("first_order_id"), py::arg("last_order_id"),
+               py::arg("half_spread") = 0.05, py::arg("quote_quantity") = 10, py::arg("max_inventory") = 100,
+               py::arg("inventory_skew") = 0.0, py::arg("initial_price") = 10.0,
+               "Create a market maker agent\n\n"
+               "Args:\n"
+               "    trader_id (int): Identifier of the trader\n"
+               "    first_order_id (int): First order id of the agent's id range\n"
+               "    last_order_id (int): End (exclusive) of the agent's id range\n"
+               "    half_spread (float, optional): Distance of each quote from the mid price\n"
+               "    quote_quantity (int, optional): Quantity of each quote\n"
+               "    max_inventory (int, optional): Stop quoting a side beyond this position\n"
+               "    inventory_skew (float, optional): Quote shift per unit of inventory\n"
+               "    initial_price (float, optional): Reference price until the book has a mid")
+          .def_property_readonly("inventory", &MarketMakerAgent::get_inventory, "Current position")
+          .def_property_readonly("cash", &MarketMakerAgent::get_cash, "Cash from all fills")
+          .def("__repr__", [](const MarketMakerAgent &x) {
+               return "<MarketMakerAgent trader_id=" + std::to_string(x.get_trader_id()) +
+                      " inventory=" + std::to_string(x.get_inventory()) + ">";
+          });
+
      // =============================================
      // Simulator Class
      // =============================================
@@ -568,17 +1032,26 @@ PYBIND11_MODULE(market_simulator, m) {
 
      // Expose the Simulator class
      py::class_<Simulator>(m, "Simulator", "Order book market simulator")
-         .def(py::init<Timestamp>(), 
-              py::arg("start_time") = 0,
+         .def(py::init<Timestamp, std::shared_ptr<EventSink>>(), 
+              py::arg("start_time") = 0, py::arg("sink") = py::none(),
               "Initialize the simulator with an optional start time\n\n"
               "Args:\n"
-              "    start_time (float, optional): Simulation start timestamp (default is 0)")
+              "    start_time (float, optional): Simulation start timestamp (default is 0)\n"
+              "    sink (EventSink, optional): Destination of trade/order events (default MemorySink)")
+
+         .def(py::init<Timestamp, const LadderConfig&, std::shared_ptr<EventSink>>(),
+              py::arg("start_time"), py::arg("ladder"), py::arg("sink") = py::none(),
+              "Initialize the simulator with a tick ladder order book\n\n"
+              "Args:\n"
+              "    start_time (float): Simulation start timestamp\n"
+              "    ladder (LadderConfig): Tick size and price band of the book\n"
+              "    sink (EventSink, optional): Destination of trade/order events (default MemorySink)")
 
          // Limit and market orders
          .def("place_limit_order", &Simulator::place_limit_order, 
               "Place a limit order into the order book\n\n"
               "Args:\n"
-              "    pending_order (PendingOrder): The pending limit order to place",
+              "    pending_order (PendingOrder): The pending limit order to place, its type picks LIMIT, IOC, FOK or POST_ONLY",
               py::arg("pending_order"))
 
          .def("place_market_order", &Simulator::place_market_order,
@@ -587,6 +1060,156 @@ PYBIND11_MODULE(market_simulator, m) {
               "    pending_market_order (PendingMarketOrder): The pending market order to place",
               py::arg("pending_market_order"))
 
+          // Batch submission: one call for a whole population of orders, queued without holding the GIL
+          .def("place_limit_orders_batch",
+               [](Simulator &sim, Column<OrderID> order_ids, Column<TraderID> trader_ids, Column<Price> prices,
+                  Column<Quantity> quantities, Column<std::uint8_t> sides, std::optional<Column<std::uint8_t>> types) {
+                    std::size_t count = batch_size({order_ids.size(), trader_ids.size(), prices.size(), quantities.size(), sides.size()});
+                    if (types) {
+                         batch_size({sides.size(), types->size()});
+                    }
+                    py::array_t<std::uint8_t> status(static_cast<py::ssize_t>(count));
+                    auto *status_out = reinterpret_cast<SubmitStatus*>(status.mutable_data());
+                    {
+                         py::gil_scoped_release release;
+                         sim.place_limit_orders_batch(order_ids.data(), trader_ids.data(), prices.data(),
+                                                      quantities.data(), sides.data(), types ? types->data() : nullptr,
+                                                      count, status_out);
+                    }
+                    return status;
+               },
+               "Queue many limit orders at once from NumPy arrays\n\n"
+               "Args:\n"
+               "    order_ids (numpy.ndarray): Unique identifiers of the orders (uint64)\n"
+               "    trader_ids (numpy.ndarray): Identifiers of the traders (uint64)\n"
+               "    prices (numpy.ndarray): Limit prices (float64)\n"
+               "    quantities (numpy.ndarray): Number of shares/contracts (uint32)\n"
+               "    sides (numpy.ndarray): Side codes, 0 = BUY, 1 = SELL (uint8)\n"
+               "    types (numpy.ndarray, optional): OrderType codes LIMIT, IOC, FOK or POST_ONLY (uint8), all LIMIT if omitted\n\n"
+               "Returns:\n"
+               "    numpy.ndarray: One SubmitStatus code (uint8) per order",
+               py::arg("order_ids"), py::arg("trader_ids"), py::arg("prices"), py::arg("quantities"), py::arg("sides"),
+               py::arg("types") = py::none())
+
+          .def("place_market_orders_batch",
+               [](Simulator &sim, Column<OrderID> order_ids, Column<TraderID> trader_ids,
+                  Column<Quantity> quantities, Column<std::uint8_t> sides) {
+                    std::size_t count = batch_size({order_ids.size(), trader_ids.size(), quantities.size(), sides.size()});
+                    py::array_t<std::uint8_t> status(static_cast<py::ssize_t>(count));
+                    auto *status_out = reinterpret_cast<SubmitStatus*>(status.mutable_data());
+                    {
+                         py::gil_scoped_release release;
+                         sim.place_market_orders_batch(order_ids.data(), trader_ids.data(),
+                                                       quantities.data(), sides.data(), count, status_out);
+                    }
+                    return status;
+               },
+               "Queue many market orders at once from NumPy arrays\n\n"
+               "Args:\n"
+               "    order_ids (numpy.ndarray): Unique identifiers of the orders (uint64)\n"
+               "    trader_ids (numpy.ndarray): Identifiers of the traders (uint64)\n"
+               "    quantities (numpy.ndarray): Number of shares/contracts (uint32)\n"
+               "    sides (numpy.ndarray): Side codes, 0 = BUY, 1 = SELL (uint8)\n\n"
+               "Returns:\n"
+               "    numpy.ndarray: One SubmitStatus code (uint8) per order",
+               py::arg("order_ids"), py::arg("trader_ids"), py::arg("quantities"), py::arg("sides"))
+
+          .def("place_orders_batch",
+               [](Simulator &sim, Column<OrderID> order_ids, Column<TraderID> trader_ids, Column<Price> prices,
+                  Column<Quantity> quantities, Column<std::uint8_t> sides, Column<std::uint8_t> types) {
+                    std::size_t count = batch_size({order_ids.size(), trader_ids.size(), prices.size(), quantities.size(),
+                                                    sides.size(), types.size()});
+                    py::array_t<std::uint8_t> status(static_cast<py::ssize_t>(count));
+                    auto *status_out = reinterpret_cast<SubmitStatus*>(status.mutable_data());
+                    {
+                         py::gil_scoped_release release;
+                         sim.place_orders_batch(order_ids.data(), trader_ids.data(), prices.data(),
+                                                quantities.data(), sides.data(), types.data(), count, status_out);
+                    }
+                    return status;
+               },
+               "Queue a mix of limit and market orders at once from NumPy arrays, in array order\n\n"
+               "Args:\n"
+               "    order_ids (numpy.ndarray): Unique identifiers of the orders (uint64)\n"
+               "    trader_ids (numpy.ndarray): Identifiers of the traders (uint64)\n"
+               "    prices (numpy.ndarray): Limit prices, ignored for market orders (float64)\n"
+               "    quantities (numpy.ndarray): Number of shares/contracts (uint32)\n"
+               "    sides (numpy.ndarray): Side codes, 0 = BUY, 1 = SELL (uint8)\n"
+               "    types (numpy.ndarray): OrderType codes, MARKET included (uint8)\n\n"
+               "Returns:\n"
+               "    numpy.ndarray: One SubmitStatus code (uint8) per order",
+               py::arg("order_ids"), py::arg("trader_ids"), py::arg("prices"), py::arg("quantities"), py::arg("sides"),
+               py::arg("types"))
+
+          // Same as place_orders_batch for a list of PendingOrder / PendingMarketOrder objects: the fields
+          // are read in C++, one cast per order instead of one Python attribute lookup per field
+          .def("place_orders",
+               [](Simulator &sim, py::sequence orders) {
+                    std::size_t count = static_cast<std::size_t>(py::len(orders));
+                    std::vector<OrderID> order_ids(count);
+                    std::vector<TraderID> trader_ids(count);
+                    std::vector<Price> prices(count, 0.0);
+                    std::vector<Quantity> quantities(count);
+                    std::vector<std::uint8_t> sides(count);
+                    std::vector<std::uint8_t> types(count);
+                    for (std::size_t i = 0; i < count; ++i) {
+                         py::handle item = orders[i];
+                         if (py::isinstance<PendingOrder>(item)) {
+                              const auto &order = item.cast<const PendingOrder &>();
+                              order_ids[i] = order.order_id;
+                              trader_ids[i] = order.trader_id;
+                              prices[i] = order.price;
+                              quantities[i] = order.quantity;
+                              sides[i] = static_cast<std::uint8_t>(order.side);
+                              types[i] = static_cast<std::uint8_t>(order.type);
+                         } else if (py::isinstance<PendingMarketOrder>(item)) {
+                              const auto &order = item.cast<const PendingMarketOrder &>();
+                              order_ids[i] = order.order_id;
+                              trader_ids[i] = order.trader_id;
+                              quantities[i] = order.quantity;
+                              sides[i] = static_cast<std::uint8_t>(order.side);
+                              types[i] = static_cast<std::uint8_t>(OrderType::MARKET);
+                         } else {
+                              throw py::type_error("Expected PendingOrder or PendingMarketOrder");
+                         }
+                    }
+                    py::array_t<std::uint8_t> status(static_cast<py::ssize_t>(count));
+                    auto *status_out = reinterpret_cast<SubmitStatus*>(status.mutable_data());
+                    {
+                         py::gil_scoped_release release;
+                         sim.place_orders_batch(order_ids.data(), trader_ids.data(), prices.data(),
+                                                quantities.data(), sides.data(), types.data(), count, status_out);
+                    }
+                    return status;
+               },
+               "Queue a list of PendingOrder and PendingMarketOrder objects in one call, in list order\n\n"
+               "Args:\n"
+               "    orders (Sequence[PendingOrder | PendingMarketOrder]): Orders to queue\n\n"
+               "Returns:\n"
+               "    numpy.ndarray: One SubmitStatus code (uint8) per order, in list order",
+               py::arg("orders"))
+
+          // Native agents
+          .def("add_agent", &Simulator::add_agent,
+               "Register a native agent to be driven by run()\n\n"
+               "Args:\n"
+               "    agent (Agent): Agent with a trader id not used by any other agent",
+               py::arg("agent"))
+
+          .def("get_agents", &Simulator::get_agents,
+               "Get the registered native agents\n\n"
+               "Returns:\n"
+               "    List[Agent]: Agents in registration order")
+
+          .def("run", &Simulator::run, py::call_guard<py::gil_scoped_release>(),
+               "Run the native agents for n_ticks entirely in C++, without holding the GIL\n\n"
+               "Each tick feeds every agent the top of book, submits their orders,\n"
+               "reports fills back to them and advances time by time_step\n\n"
+               "Args:\n"
+               "    n_ticks (int): Number of ticks to run\n"
+               "    time_step (int, optional): Time advanced after each tick",
+               py::arg("n_ticks"), py::arg("time_step") = 1)
+
           .def("get_all_trader_orders", &Simulator::get_all_trader_orders,
                "Get all orders for a specific trader\n\n"
                "Args:\n"
@@ -603,6 +1226,8 @@ PYBIND11_MODULE(market_simulator, m) {
 
           .def("modify_order", &Simulator::modify_order,
                "Modify an existing order's price and/or quantity\n\n"
+               "A quantity decrease at the same price keeps queue priority,\n"
+               "any other change requeues the order\n\n"
                "Args:\n"
                "    order_id (int): Unique identifier of the order to modify\n"
                "    new_price (float): New price for the order\n"
@@ -612,7 +1237,28 @@ PYBIND11_MODULE(market_simulator, m) {
           // Submit pending orders
           .def("submit_pending_orders", &Simulator::submit_pending_orders, 
                "Submit all pending orders to the order book\n\n"
-               "Processes queued orders and matches them against the book")
+               "Processes queued orders, in the order chosen by the SequencingPolicy,\n"
+               "and matches them against the book")
+
+          .def("get_pending_order_count", &Simulator::get_pending_order_count,
+               "Get the number of orders waiting for submit_pending_orders\n\n"
+               "Returns:\n"
+               "    int: Number of queued orders")
+
+          .def("set_sequencing_policy", &Simulator::set_sequencing_policy,
+               "Choose the order in which submit_pending_orders hands orders to the book\n\n"
+               "Args:\n"
+               "    policy (SequencingPolicy): Sequencing policy\n"
+               "    seed (int, optional): Seed of the SHUFFLE / LATENCY random generator\n"
+               "    latency_jitter (int, optional): Maximum random delay added per order in LATENCY mode",
+               py::arg("policy"), py::arg("seed") = 0, py::arg("latency_jitter") = 0)
+
+          .def("set_trader_latency", &Simulator::set_trader_latency,
+               "Set the fixed delay of a trader's orders in LATENCY mode\n\n"
+               "Args:\n"
+               "    trader_id (int): Identifier of the trader\n"
+               "    latency (int): Delay added to the trader's arrival time",
+               py::arg("trader_id"), py::arg("latency"))
 
           // Book data
           .def("get_current_level1_data", &Simulator::get_current_level1_data, 
@@ -625,11 +1271,80 @@ PYBIND11_MODULE(market_simulator, m) {
               "Returns:\n"
               "    Level2Data: Current order book depth data")
 
+          .def("can_fill", &Simulator::can_fill,
+              "Check whether an order could fill completely right now, without changing the book\n\n"
+              "Args:\n"
+              "    side (OrderSide): Side of the incoming order\n"
+              "    price (float): Limit price of the incoming order\n"
+              "    quantity (int): Quantity that has to be available\n\n"
+              "Returns:\n"
+              "    bool: True if the other side holds quantity at prices up to (or down to) price",
+              py::arg("side"), py::arg("price"), py::arg("quantity"))
+
           .def("get_current_snapshot", &Simulator::get_current_snapshot, 
               "Get full order book snapshot\n\n"
               "Returns:\n"
               "    OrderBookSnapshot: Current full order book state")
 
+          .def("get_depth_into", [price_level_dtype](const Simulator &self, py::array bids, py::array asks) {
+                    PriceLevel* bid_out = level_buffer(bids, price_level_dtype, "bids");
+                    PriceLevel* ask_out = level_buffer(asks, price_level_dtype, "asks");
+                    std::size_t bid_count = self.copy_current_levels(OrderSide::BUY, bid_out, static_cast<std::size_t>(bids.shape(0)));
+                    std::size_t ask_count = self.copy_current_levels(OrderSide::SELL, ask_out, static_cast<std::size_t>(asks.shape(0)));
+                    return py::make_tuple(bid_count, ask_count);
+               },
+               "Write the best levels into preallocated arrays, nothing is allocated per call\n\n"
+               "Args:\n"
+               "    bids (np.ndarray): price_level_dtype array, its length is the bid depth\n"
+               "    asks (np.ndarray): price_level_dtype array, its length is the ask depth\n\n"
+               "Returns:\n"
+               "    Tuple[int, int]: Number of bid and ask levels written (best first)",
+               py::arg("bids").noconvert(), py::arg("asks").noconvert())
+
+          .def("enable_level2_updates", &Simulator::enable_level2_updates,
+               "Start logging changed price levels for get_level2_updates\n\n"
+               "Args:\n"
+               "    capacity (int, optional): Changes kept for readers that fall behind (rounded up to a power of two)\n"
+               "    snapshot_interval (int, optional): Send a full snapshot whenever a reader crosses a multiple of this sequence, 0 = never",
+               py::arg("capacity") = 1 << 16, py::arg("snapshot_interval") = 0)
+
+          .def("get_level2_updates", &Simulator::get_level2_updates,
+               "Get the price levels changed since a sequence\n\n"
+               "Args:\n"
+               "    since_sequence (int): Sequence of the previous answer, 0 for a first full snapshot\n\n"
+               "Returns:\n"
+               "    Level2Updates: Changes in order, or a full snapshot when the caller has to resync",
+               py::arg("since_sequence"))
+
+          .def("reserve", &Simulator::reserve,
+               "Pre-size the book's order store, order index and price level pools\n\n"
+               "Args:\n"
+               "    orders (int): Resting orders to make room for\n"
+               "    levels (int): Price levels per side to make room for",
+               py::arg("orders"), py::arg("levels"))
+
+          // Instrumentation
+          .def("get_engine_stats", &Simulator::get_engine_stats,
+               "Get per-operation TSC latency, fills, levels walked and allocating calls of the book\n\n"
+               "Returns:\n"
+               "    EngineStats: Counters since the last reset, enabled is False when compiled out")
+
+          .def("reset_engine_stats", &Simulator::reset_engine_stats,
+               "Clear the engine stats counters and histograms")
+
+          // Validation
+          .def("set_invariant_mode", &Simulator::set_invariant_mode,
+               "Choose how much book validation runs after each order\n\n"
+               "Args:\n"
+               "    mode (InvariantMode): Validation mode\n"
+               "    sample_interval (int, optional): Order events between full scans in SAMPLED mode",
+               py::arg("mode"), py::arg("sample_interval") = 1024)
+
+          .def("validate_book", &Simulator::validate_book,
+               "Run a full validation pass over the order book\n\n"
+               "Raises:\n"
+               "    RuntimeError: If an invariant is violated")
+
           // Time management
           .def("advance_time", &Simulator::advance_time, 
                "Advance simulation time by dt\n\n"
@@ -645,12 +1360,341 @@ PYBIND11_MODULE(market_simulator, m) {
           // logs
           .def("get_order_logs", &Simulator::get_order_logs,
                "Get the order logs\n\n"
+               "Args:\n"
+               "    since (int, optional): Only return entries with this sequence number or later\n\n"
                "Returns:\n"
-               "    List[OrderLog]: List of all order log entries")
+               "    List[OrderLog]: Order log entries held by the event sink",
+               py::arg("since") = 0)
 
           .def("get_trade_logs", &Simulator::get_trade_logs,
                "Get the trade logs\n\n"
+               "Args:\n"
+               "    since (int, optional): Only return entries with this sequence number or later\n\n"
+               "Returns:\n"
+               "    List[TradeLog]: Trade log entries held by the event sink",
+               py::arg("since") = 0)
+
+          // NumPy log access: views into the sink's storage when possible, see sink_records
+          .def("get_order_logs_array", [](py::object self, std::uint64_t since) {
+                    const EventSink &sink = self.cast<const Simulator&>().get_event_sink();
+                    return sink_records<OrderLog>(make_dtype(order_log_fields(0), sizeof(OrderLog)), sink.has_stable_spans(), self,
+                                                  [&](const EventSink::SpanFn<OrderLog> &fn) { sink.order_log_spans(since, fn); });
+               },
+               "Get the order logs as a NumPy structured array\n\n"
+               "With the default MemorySink the array is usually a read-only view without any copy.\n"
+               "The view is only valid until the book or its event sink is cleared: clear() reuses the\n"
+               "storage, so later records show through. Copy it (np.array(view)) to keep it longer\n\n"
+               "Args:\n"
+               "    since (int, optional): Only return entries with this sequence number or later\n\n"
+               "Returns:\n"
+               "    numpy.ndarray: One record per order log entry",
+               py::arg("since") = 0)
+
+          .def("get_trade_logs_array", [](py::object self, std::uint64_t since) {
+                    const EventSink &sink = self.cast<const Simulator&>().get_event_sink();
+                    return sink_records<Trade>(make_dtype(trade_fields(0), sizeof(Trade)), sink.has_stable_spans(), self,
+                                               [&](const EventSink::SpanFn<Trade> &fn) { sink.trade_spans(since, fn); });
+               },
+               "Get the trade logs as a NumPy structured array\n\n"
+               "With the default MemorySink the array is usually a read-only view without any copy.\n"
+               "The view is only valid until the book or its event sink is cleared: clear() reuses the\n"
+               "storage, so later records show through. Copy it (np.array(view)) to keep it longer\n\n"
+               "Args:\n"
+               "    since (int, optional): Only return trades with this sequence number or later\n\n"
+               "Returns:\n"
+               "    numpy.ndarray: One record per trade",
+               py::arg("since") = 0)
+
+          .def("get_order_log_sequence", [](const Simulator &sim) { return sim.get_event_sink().order_log_sequence(); },
+               "Sequence number the next order log entry will get\n\n"
+               "Pass it as `since` on the next poll to fetch only new entries")
+
+          .def("get_trade_sequence", [](const Simulator &sim) { return sim.get_event_sink().trade_sequence(); },
+               "Sequence number the next trade will get\n\n"
+               "Pass it as `since` on the next poll to fetch only new trades")
+
+          .def("flush_events", [](Simulator &sim) { sim.get_event_sink().flush(); },
+               "Flush buffered events of the event sink (e.g. BinaryFileSink) to their destination");
+
+     // =============================================
+     // Multi-Book Simulator Class
+     // =============================================
+
+     py::class_<MultiBookSimulator>(m, "MultiBookSimulator", "Independent order books per instrument, matched in parallel")
+          .def(py::init([](std::size_t num_books, std::size_t num_threads, std::optional<LadderConfig> ladder,
+                           InvariantMode invariant_mode, Timestamp start_time) {
+                    MultiBookConfig config;
+                    config.num_books = num_books;
+                    config.num_threads = num_threads;
+                    config.ladder = ladder;
+                    config.invariant_mode = invariant_mode;
+                    return std::make_unique<MultiBookSimulator>(config, start_time);
+               }),
+               py::arg("num_books"), py::arg("num_threads") = 0, py::arg("ladder") = py::none(),
+               py::arg("invariant_mode") = ORDER_BOOK_DEFAULT_INVARIANT_MODE, py::arg("start_time") = 0,
+               "Initialize one order book per instrument\n\n"
+               "Args:\n"
+               "    num_books (int): Number of instruments (ids 0 .. num_books - 1)\n"
+               "    num_threads (int, optional): Worker threads, 0 = one per hardware thread\n"
+               "    ladder (LadderConfig, optional): Use tick ladder books with this configuration\n"
+               "    invariant_mode (InvariantMode, optional): Validation mode of every book\n"
+               "    start_time (int, optional): Simulation start timestamp")
+
+          .def_property_readonly("num_books", &MultiBookSimulator::get_num_books, "Number of instruments")
+          .def_property_readonly("num_threads", &MultiBookSimulator::get_num_threads, "Number of worker threads")
+
+          .def("place_limit_order", &MultiBookSimulator::place_limit_order,
+               "Queue a limit order for one instrument\n\n"
+               "Args:\n"
+               "    instrument (int): Instrument id\n"
+               "    pending_order (PendingOrder): The pending limit order to place",
+               py::arg("instrument"), py::arg("pending_order"))
+
+          .def("place_market_order", &MultiBookSimulator::place_market_order,
+               "Queue a market order for one instrument\n\n"
+               "Args:\n"
+               "    instrument (int): Instrument id\n"
+               "    pending_market_order (PendingMarketOrder): The pending market order to place",
+               py::arg("instrument"), py::arg("pending_market_order"))
+
+          .def("cancel_order", &MultiBookSimulator::cancel_order,
+               "Cancel an existing order of one instrument\n\n"
+               "Args:\n"
+               "    instrument (int): Instrument id\n"
+               "    order_id (int): Unique identifier of the order to cancel",
+               py::arg("instrument"), py::arg("order_id"))
+
+          .def("modify_order", &MultiBookSimulator::modify_order,
+               "Modify an existing order of one instrument\n\n"
+               "Args:\n"
+               "    instrument (int): Instrument id\n"
+               "    order_id (int): Unique identifier of the order to modify\n"
+               "    new_price (float): New price for the order\n"
+               "    new_quantity (int): New quantity for the order",
+               py::arg("instrument"), py::arg("order_id"), py::arg("new_price"), py::arg("new_quantity"))
+
+          .def("submit_pending_orders", &MultiBookSimulator::submit_pending_orders, py::call_guard<py::gil_scoped_release>(),
+               "Match the pending orders of every book in parallel, without holding the GIL")
+
+          .def("get_level1_data", &MultiBookSimulator::get_level1_data,
+               "Get top of book data of one instrument\n\n"
+               "Args:\n"
+               "    instrument (int): Instrument id",
+               py::arg("instrument"))
+
+          .def("get_level2_data", &MultiBookSimulator::get_level2_data,
+               "Get Level 2 market data of one instrument\n\n"
+               "Args:\n"
+               "    instrument (int): Instrument id",
+               py::arg("instrument"))
+
+          .def("get_all_level1_data", &MultiBookSimulator::get_all_level1_data,
+               "Get top of book data of every instrument\n\n"
+               "Returns:\n"
+               "    List[Level1Data]: One entry per instrument id")
+
+          .def("get_trade_logs", &MultiBookSimulator::get_trade_logs,
+               "Get the trades of all books, merged in a thread-count independent order\n\n"
+               "Returns:\n"
+               "    List[Tuple[int, TradeLog]]: (instrument, trade) pairs")
+
+          .def("get_order_logs", &MultiBookSimulator::get_order_logs,
+               "Get the order logs of all books, merged in a thread-count independent order\n\n"
+               "Returns:\n"
+               "    List[Tuple[int, OrderLog]]: (instrument, order log) pairs")
+
+          .def("get_book_trade_logs", &MultiBookSimulator::get_book_trade_logs,
+               "Get the trades of one instrument",
+               py::arg("instrument"))
+
+          .def("get_book_order_logs", &MultiBookSimulator::get_book_order_logs,
+               "Get the order logs of one instrument",
+               py::arg("instrument"))
+
+          .def("advance_time", &MultiBookSimulator::advance_time,
+               "Advance simulation time of every book by dt\n\n"
+               "Args:\n"
+               "    dt (int): Time increment to advance",
+               py::arg("dt"))
+
+          .def("get_current_time", &MultiBookSimulator::get_current_time,
+               "Get the current simulation time");
+
+     // =============================================
+     // Monte-Carlo Batch Runner
+     // =============================================
+
+     py::class_<ScenarioSpec>(m, "ScenarioSpec", "Scenario run by every replica of run_monte_carlo")
+          .def(py::init<>())
+          .def_readwrite("n_ticks", &ScenarioSpec::n_ticks, "Ticks per replica")
+          .def_readwrite("time_step", &ScenarioSpec::time_step, "Time advanced per tick")
+          .def_readwrite("ladder", &ScenarioSpec::ladder, "Tick ladder configuration, None for the map book")
+          .def_readwrite("invariant_mode", &ScenarioSpec::invariant_mode, "Validation mode of each replica's book")
+          .def_readwrite("initial_bid", &ScenarioSpec::initial_bid, "Opening bid price")
+          .def_readwrite("initial_ask", &ScenarioSpec::initial_ask, "Opening ask price")
+          .def_readwrite("initial_quantity", &ScenarioSpec::initial_quantity, "Quantity of the opening quotes")
+          .def_readwrite("num_random_agents", &ScenarioSpec::num_random_agents, "Number of RandomAgents")
+          .def_readwrite("trading_probability", &ScenarioSpec::trading_probability, "Default chance of a RandomAgent to trade each tick")
+          .def_readwrite("market_maker", &ScenarioSpec::market_maker, "Add a MarketMakerAgent")
+          .def_readwrite("half_spread", &ScenarioSpec::half_spread, "Default half spread of the market maker")
+          .def_readwrite("quote_quantity", &ScenarioSpec::quote_quantity, "Quantity of each market maker quote")
+          .def_readwrite("max_inventory", &ScenarioSpec::max_inventory, "Inventory limit of the market maker")
+          .def_readwrite("inventory_skew", &ScenarioSpec::inventory_skew, "Default inventory skew of the market maker")
+          .def("__repr__", [](const ScenarioSpec &x) {
+               return "<ScenarioSpec n_ticks=" + std::to_string(x.n_ticks) +
+                      " num_random_agents=" + std::to_string(x.num_random_agents) + ">";
+          });
+
+     m.def("run_monte_carlo",
+          [](const ScenarioSpec &spec, Column<std::uint64_t> seeds, std::optional<Column<double>> trading_probability,
+             std::optional<Column<double>> half_spread, std::optional<Column<double>> inventory_skew, std::size_t num_threads) {
+               std::size_t count = static_cast<std::size_t>(seeds.size());
+               std::vector<ReplicaParams> replicas(count);
+               for (std::size_t i = 0; i < count; ++i) {
+                    replicas[i].seed = seeds.data()[i];
+               }
+               // Omitted columns leave the override unset, so the replica uses the spec's value
+               auto column = [&replicas, count](const std::optional<Column<double>> &values, std::optional<double> ReplicaParams::*field,
+                                                const char *name) {
+                    if (!values) {
+                         return;
+                    }
+                    if (static_cast<std::size_t>(values->size()) != count) {
+                         throw py::value_error(std::string(name) + " must have one value per seed");
+                    }
+                    for (std::size_t i = 0; i < count; ++i) {
+                         replicas[i].*field = values->data()[i];
+                    }
+               };
+               column(trading_probability, &ReplicaParams::trading_probability, "trading_probability");
+               column(half_spread, &ReplicaParams::half_spread, "half_spread");
+               column(inventory_skew, &ReplicaParams::inventory_skew, "inventory_skew");
+
+               std::vector<ReplicaStats> results;
+               {
+                    py::gil_scoped_release release;
+                    results = run_batch(spec, replicas, num_threads);
+               }
+
+               py::array out(make_dtype(replica_stats_fields(), sizeof(ReplicaStats)),
+                             std::vector<py::ssize_t>{static_cast<py::ssize_t>(results.size())});
+               std::memcpy(out.mutable_data(), results.data(), results.size() * sizeof(ReplicaStats));
+               return out;
+          },
+          "Run independent replicas of a scenario in parallel, entirely in C++\n\n"
+          "Replicas run on a work-stealing thread pool without holding the GIL\n\n"
+          "Args:\n"
+          "    spec (ScenarioSpec): Scenario shared by all replicas\n"
+          "    seeds (numpy.ndarray): One seed per replica (uint64)\n"
+          "    trading_probability (numpy.ndarray, optional): Per-replica RandomAgent trading probability\n"
+          "    half_spread (numpy.ndarray, optional): Per-replica market maker half spread\n"
+          "    inventory_skew (numpy.ndarray, optional): Per-replica market maker inventory skew\n"
+          "    num_threads (int, optional): Worker threads, 0 = one per hardware thread\n\n"
+          "Returns:\n"
+          "    numpy.ndarray: One structured record of statistics per replica, in seed order",
+          py::arg("spec"), py::arg("seeds"), py::arg("trading_probability") = py::none(),
+          py::arg("half_spread") = py::none(), py::arg("inventory_skew") = py::none(), py::arg("num_threads") = 0);
+
+     // =============================================
+     // Threaded Matching Engine
+     // =============================================
+
+     // One Python thread may submit and one may poll; blocking calls release the GIL
+     py::class_<MatchingEngine>(m, "MatchingEngine", "Order book matched on its own thread behind lock-free rings")
+          .def(py::init([](std::size_t command_capacity, std::size_t event_capacity, std::size_t batch_size,
+                           int cpu, std::optional<LadderConfig> ladder) {
+                    EngineConfig config;
+                    config.command_capacity = command_capacity;
+                    config.event_capacity = event_capacity;
+                    config.batch_size = batch_size;
+                    config.cpu = cpu;
+                    return std::make_unique<MatchingEngine>(config, ladder);
+               }),
+               py::arg("command_capacity") = 1 << 16, py::arg("event_capacity") = 1 << 18,
+               py::arg("batch_size") = 256, py::arg("cpu") = -1, py::arg("ladder") = py::none(),
+               "Create a stopped matching engine\n\n"
+               "Args:\n"
+               "    command_capacity (int, optional): Slots of the order command ring\n"
+               "    event_capacity (int, optional): Slots of the trade/order event ring\n"
+               "    batch_size (int, optional): Commands matched per batch\n"
+               "    cpu (int, optional): Core to pin the matching thread to (Linux), -1 = no pinning\n"
+               "    ladder (LadderConfig, optional): Use a tick ladder book with this configuration")
+
+          .def("start", &MatchingEngine::start, "Start the matching thread")
+          .def("stop", &MatchingEngine::stop, py::call_guard<py::gil_scoped_release>(),
+               "Match every submitted command, then stop the matching thread")
+          .def_property_readonly("running", &MatchingEngine::is_running, "Whether the matching thread runs")
+          .def_property_readonly("failed", &MatchingEngine::has_failed,
+                                 "Whether a command made the book throw; submits then raise and stop() rethrows the error")
+
+          .def("submit_limit_order", [](MatchingEngine &engine, const PendingOrder &order, Timestamp timestamp) {
+                    py::gil_scoped_release release;
+                    engine.submit(OrderCommand{order.order_id, order.trader_id, order.price, order.quantity,
+                                               order_command_type(order.type), order.side, timestamp});
+               },
+               "Queue a limit order (LIMIT, IOC, FOK or POST_ONLY, from pending_order.type) for the matching thread",
+               py::arg("pending_order"), py::arg("timestamp") = 0)
+
+          .def("submit_market_order", [](MatchingEngine &engine, const PendingMarketOrder &order, Timestamp timestamp) {
+                    py::gil_scoped_release release;
+                    engine.submit(OrderCommand{order.order_id, order.trader_id, 0.0, order.quantity,
+                                               CommandType::MARKET, order.side, timestamp});
+               },
+               "Queue a market order for the matching thread",
+               py::arg("pending_market_order"), py::arg("timestamp") = 0)
+
+          .def("submit_cancel", [](MatchingEngine &engine, OrderID order_id) {
+                    py::gil_scoped_release release;
+                    engine.submit(OrderCommand{order_id, 0, 0.0, 0, CommandType::CANCEL, OrderSide::BUY, 0});
+               },
+               "Queue a cancel for the matching thread",
+               py::arg("order_id"))
+
+          .def("submit_modify", [](MatchingEngine &engine, OrderID order_id, Price new_price, Quantity new_quantity) {
+                    py::gil_scoped_release release;
+                    engine.submit(OrderCommand{order_id, 0, new_price, new_quantity, CommandType::MODIFY, OrderSide::BUY, 0});
+               },
+               "Queue a modify for the matching thread",
+               py::arg("order_id"), py::arg("new_price"), py::arg("new_quantity"))
+
+          .def("poll_events", [](MatchingEngine &engine, std::size_t max_events) {
+                    std::vector<Trade> trades;
+                    std::vector<OrderLog> logs;
+                    EngineEvent event;
+                    for (std::size_t n = 0; (max_events == 0 || n < max_events) && engine.poll_event(event); ++n) {
+                         if (event.type == EngineEventType::TRADE) {
+                              trades.push_back(event.trade);
+                         } else {
+                              logs.push_back(event.log);
+                         }
+                    }
+                    return py::make_tuple(trades, logs);
+               },
+               "Take the trades and order events published so far\n\n"
+               "Args:\n"
+               "    max_events (int, optional): Stop after this many events, 0 = all waiting\n\n"
                "Returns:\n"
-               "    List[TradeLog]: List of all trade log entries");
+               "    Tuple[List[TradeLog], List[OrderLog]]: Trades and order logs in publication order",
+               py::arg("max_events") = 0)
+
+          .def_property_readonly("processed_commands", &MatchingEngine::get_processed_commands, "Commands matched so far")
+          .def_property_readonly("dropped_events", &MatchingEngine::get_dropped_events, "Events dropped at shutdown because nobody polled")
+
+          .def("get_level1_data", [](MatchingEngine &engine) { return engine.get_order_book().get_level1_data(); },
+               "Get top of book data (only while stopped)")
+
+          .def("get_published_level1", [](const MatchingEngine &engine) { return engine.get_market_data().read_level1(); },
+               "Top of book as of the last matched batch, readable while the engine runs")
+          .def("get_published_level2", [](const MatchingEngine &engine) {
+                    const DepthN<PUBLISHED_DEPTH> depth = engine.get_market_data().read_depth().depth;
+                    Level2Data data;
+                    data.timestamp = depth.timestamp;
+                    data.bids.assign(depth.bids.begin(), depth.bids.begin() + depth.bid_count);
+                    data.asks.assign(depth.asks.begin(), depth.asks.begin() + depth.ask_count);
+                    return data;
+               },
+               "Best levels per side as of the last matched batch, readable while the engine runs")
+          .def_property_readonly("published_version", [](const MatchingEngine &engine) { return engine.get_market_data().version(); },
+               "Number of market data publications so far");
 
-}
\ No newline at end of file
+}
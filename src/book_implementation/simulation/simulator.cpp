@@ -1,29 +1,45 @@
 #include "simulator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 
 // =============================================
 // Simulator Class Implementation
 // =============================================S
 
 // Constructor to initialize the simulator with a start time
-Simulator::Simulator(Timestamp start_time = 0) {
+Simulator::Simulator(Timestamp start_time, std::shared_ptr<EventSink> event_sink)
+    : fill_capture(std::make_shared<FillCaptureSink>(event_sink ? std::move(event_sink) : std::make_shared<MemorySink>())),
+      order_book(fill_capture) {
     simulation_time = start_time;
     
     // Initialize the order book
     order_book.advance_time(simulation_time);
 }
 
+// Constructor for a simulator backed by a tick ladder order book
+Simulator::Simulator(Timestamp start_time, const LadderConfig& ladder_config, std::shared_ptr<EventSink> event_sink)
+    : fill_capture(std::make_shared<FillCaptureSink>(event_sink ? std::move(event_sink) : std::make_shared<MemorySink>())),
+      order_book(ladder_config, fill_capture) {
+    simulation_time = start_time;
+    order_book.advance_time(simulation_time);
+}
+
 // Place a limit order into the simulatorS - only place, do not submit yet
 void Simulator::place_limit_order(PendingOrder pending_order) {
+    if (pending_order.type == OrderType::MARKET) {
+        throw std::runtime_error("PendingOrder needs a limit-priced type, use place_market_order for market orders");
+    }
     Order order;
     order.order_id = pending_order.order_id;
     order.trader_id = pending_order.trader_id;
     order.price = pending_order.price;
     order.quantity = pending_order.quantity;
     order.side = pending_order.side;
-    order.type = OrderType::LIMIT;
+    order.type = pending_order.type;
     order.timestamp = simulation_time;
     
-    pending_orders[pending_order.trader_id] = order;
+    pending_orders.push_back(order);
 }
 
 // Place a market order into the simulatorS - only place, do not submit yetS
@@ -37,21 +53,141 @@ void Simulator::place_market_order(PendingMarketOrder pending_market_order) {
     order.type = OrderType::MARKET;
     order.timestamp = simulation_time;
     
-    pending_orders[pending_market_order.trader_id] = order;
+    pending_orders.push_back(order);
+}
+
+// Validate one order of a batch and queue it like place_limit_order / place_market_order
+SubmitStatus Simulator::enqueue_batch_order(Order& order, std::uint8_t side_code, std::uint8_t type_code) {
+    if (type_code > static_cast<std::uint8_t>(OrderType::POST_ONLY)) {
+        return SubmitStatus::INVALID_TYPE;
+    }
+    order.type = static_cast<OrderType>(type_code);
+    if (order.type == OrderType::MARKET) {
+        order.price = 0.0; // Price is irrelevant for market orders
+    }
+    if (side_code > static_cast<std::uint8_t>(OrderSide::SELL)) {
+        return SubmitStatus::INVALID_SIDE;
+    }
+    if (order.quantity == 0) {
+        return SubmitStatus::INVALID_QUANTITY;
+    }
+    if (order.type != OrderType::MARKET && !(std::isfinite(order.price) && order.price > 0.0)) {
+        return SubmitStatus::INVALID_PRICE;
+    }
+    order.side = static_cast<OrderSide>(side_code);
+    order.timestamp = simulation_time;
+
+    pending_orders.push_back(order);
+    return SubmitStatus::ACCEPTED;
+}
+
+// Queue a whole batch of limit orders from columnar arrays
+void Simulator::place_limit_orders_batch(const OrderID* order_ids, const TraderID* trader_ids, const Price* prices,
+                                         const Quantity* quantities, const std::uint8_t* sides, const std::uint8_t* types,
+                                         std::size_t count, SubmitStatus* status) {
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint8_t type_code = types ? types[i] : static_cast<std::uint8_t>(OrderType::LIMIT);
+        if (type_code == static_cast<std::uint8_t>(OrderType::MARKET)) {
+            status[i] = SubmitStatus::INVALID_TYPE;
+            continue;
+        }
+        Order order;
+        order.order_id = order_ids[i];
+        order.trader_id = trader_ids[i];
+        order.price = prices[i];
+        order.quantity = quantities[i];
+        status[i] = enqueue_batch_order(order, sides[i], type_code);
+    }
+}
+
+// Queue a whole batch of market orders from columnar arrays
+void Simulator::place_market_orders_batch(const OrderID* order_ids, const TraderID* trader_ids,
+                                          const Quantity* quantities, const std::uint8_t* sides,
+                                          std::size_t count, SubmitStatus* status) {
+    for (std::size_t i = 0; i < count; ++i) {
+        Order order;
+        order.order_id = order_ids[i];
+        order.trader_id = trader_ids[i];
+        order.quantity = quantities[i];
+        status[i] = enqueue_batch_order(order, sides[i], static_cast<std::uint8_t>(OrderType::MARKET));
+    }
+}
+
+// Queue a batch of limit and market orders from columnar arrays, keeping their order
+void Simulator::place_orders_batch(const OrderID* order_ids, const TraderID* trader_ids, const Price* prices,
+                                   const Quantity* quantities, const std::uint8_t* sides, const std::uint8_t* types,
+                                   std::size_t count, SubmitStatus* status) {
+    for (std::size_t i = 0; i < count; ++i) {
+        Order order;
+        order.order_id = order_ids[i];
+        order.trader_id = trader_ids[i];
+        order.price = prices[i];
+        order.quantity = quantities[i];
+        status[i] = enqueue_batch_order(order, sides[i], types[i]);
+    }
+}
+
+// Hand one pending order to the book
+void Simulator::submit_order(const Order& order) {
+    if (order.type == OrderType::MARKET) {
+        order_book.place_market_order(order);
+    } else {
+        order_book.place_limit_order(order);
+    }
 }
 
 // Submit all pending orders into the order book
 void Simulator::submit_pending_orders() {
-    for (const auto& [trader_id, order] : pending_orders) {
-        if (order.type == OrderType::LIMIT) {
-            order_book.place_limit_order(order);
-        } else if (order.type == OrderType::MARKET) {
-            order_book.place_market_order(order);
+    switch (sequencing_policy) {
+        case SequencingPolicy::FIFO:
+            break;
+
+        case SequencingPolicy::SHUFFLE:
+            // Fisher-Yates on the raw generator output, std::shuffle differs between standard libraries
+            for (std::size_t i = pending_orders.size(); i > 1; --i) {
+                std::size_t j = static_cast<std::size_t>(sequencing_rng() % i);
+                std::swap(pending_orders[i - 1], pending_orders[j]);
+            }
+            break;
+
+        case SequencingPolicy::LATENCY: {
+            arrival_order.clear();
+            for (std::size_t i = 0; i < pending_orders.size(); ++i) {
+                auto latency = trader_latency.find(pending_orders[i].trader_id);
+                Timestamp arrival = latency == trader_latency.end() ? 0 : latency->second;
+                if (latency_jitter > 0) {
+                    arrival += sequencing_rng() % (latency_jitter + 1);
+                }
+                arrival_order.emplace_back(arrival, static_cast<std::uint32_t>(i));
+            }
+            // Ties keep their arrival order through the index
+            std::sort(arrival_order.begin(), arrival_order.end());
+            for (const auto& [arrival, index] : arrival_order) {
+                submit_order(pending_orders[index]);
+            }
+            pending_orders.clear();
+            return;
         }
     }
+
+    for (const Order& order : pending_orders) {
+        submit_order(order);
+    }
     pending_orders.clear();
 }
 
+// Choose how submit_pending_orders() sequences the queued orders
+void Simulator::set_sequencing_policy(SequencingPolicy policy, std::uint64_t seed, Timestamp jitter) {
+    sequencing_policy = policy;
+    sequencing_rng.seed(seed);
+    latency_jitter = jitter;
+}
+
+// Fixed delay applied to a trader's orders in LATENCY mode
+void Simulator::set_trader_latency(TraderID trader_id, Timestamp latency) {
+    trader_latency[trader_id] = latency;
+}
+
 // Expose current Level 1 market data
 Level1Data Simulator::get_current_level1_data() const {
     return order_book.get_level1_data();
@@ -67,6 +203,16 @@ OrderBookSnapshot Simulator::get_current_snapshot() const {
     return order_book.get_snapshot(simulation_time);
 }
 
+// Start logging changed price levels for get_level2_updates()
+void Simulator::enable_level2_updates(std::size_t capacity, std::uint64_t snapshot_interval) {
+    order_book.enable_level2_updates(capacity, snapshot_interval);
+}
+
+// Expose the Level 2 changes since a sequence (or a resync snapshot)
+Level2Updates Simulator::get_level2_updates(std::uint64_t since_sequence) const {
+    return order_book.get_level2_updates(since_sequence);
+}
+
 // Advance the simulation time by dt millisecondsS
 void Simulator::advance_time(Timestamp dt) {
     simulation_time += dt;
@@ -88,7 +234,58 @@ void Simulator::cancel_order(OrderID order_id) {
     order_book.cancel_order(order_id);
 }
 
+// Choose how much book validation runs after each order
+void Simulator::set_invariant_mode(InvariantMode mode, std::uint32_t sample_interval) {
+    order_book.set_invariant_mode(mode, sample_interval);
+}
+
+// Run a full validation pass over the book, throws on violation
+void Simulator::validate_book() const {
+    order_book.invariant_check();
+}
+
 // Modify an existing order's price and/or quantity
 void Simulator::modify_order(OrderID order_id, Price new_price, Quantity new_quantity) {
     order_book.modify_order(order_id, new_price, new_quantity);
 }
+
+// Register a native agent for run()
+void Simulator::add_agent(std::shared_ptr<Agent> agent) {
+    if (!agent) {
+        throw std::runtime_error("Agent must not be null");
+    }
+    if (agent_by_trader.count(agent->get_trader_id()) != 0) {
+        throw std::runtime_error("An agent with this trader id is already registered");
+    }
+    agent_by_trader[agent->get_trader_id()] = agent.get();
+    agents.push_back(std::move(agent));
+}
+
+// Drive the registered agents for n_ticks without leaving C++
+void Simulator::run(std::uint64_t n_ticks, Timestamp time_step) {
+    for (std::uint64_t tick = 0; tick < n_ticks; ++tick) {
+        Level1Data market_data = order_book.get_level1_data();
+        for (const auto& agent : agents) {
+            agent->on_market_data(market_data, *this);
+        }
+
+        fill_capture->capturing = true;
+        fill_capture->trades.clear();
+        submit_pending_orders();
+        fill_capture->capturing = false;
+
+        // A trade can involve two agents (or the same agent twice)
+        for (const Trade& trade : fill_capture->trades) {
+            auto buyer = agent_by_trader.find(trade.buyer_id);
+            if (buyer != agent_by_trader.end()) {
+                buyer->second->on_fill(trade, OrderSide::BUY);
+            }
+            auto seller = agent_by_trader.find(trade.seller_id);
+            if (seller != agent_by_trader.end()) {
+                seller->second->on_fill(trade, OrderSide::SELL);
+            }
+        }
+
+        advance_time(time_step);
+    }
+}
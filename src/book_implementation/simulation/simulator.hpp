@@ -1,5 +1,8 @@
 #pragma once
 #include "../order_book/order_book.hpp"
+#include "agents/agent.hpp"
+#include <random>
+#include <unordered_map>
 
 // =============================================
 // Simulator Class Definition
@@ -12,6 +15,7 @@ struct PendingOrder {
     Price price;      // For limit orders
     Quantity quantity;
     OrderSide side;
+    OrderType type = OrderType::LIMIT;   // LIMIT, IOC, FOK or POST_ONLY
 };
 
 struct PendingMarketOrder {
@@ -21,35 +25,147 @@ struct PendingMarketOrder {
     OrderSide side;
 };
 
+// Per-order result of a batch submission
+enum class SubmitStatus : std::uint8_t {
+    ACCEPTED = 0,       // Queued
+    INVALID_QUANTITY,   // Rejected: zero quantity
+    INVALID_PRICE,      // Rejected: limit price is not a positive finite number
+    INVALID_SIDE,       // Rejected: side code is neither BUY (0) nor SELL (1)
+    INVALID_TYPE        // Rejected: unknown OrderType code, or MARKET where a limit order is expected
+};
+
+// Order in which submit_pending_orders() hands the queued orders to the book
+enum class SequencingPolicy : std::uint8_t {
+    FIFO,      // Arrival order of the place_* calls
+    SHUFFLE,   // Seeded random permutation, reproducible for a given seed
+    LATENCY    // By modelled arrival time: per-trader latency plus seeded random jitter
+};
+
+// Sits between the book and the user's event sink: forwards every event and, while agents
+// are running, also keeps the tick's trades so they can be reported back through on_fill
+class FillCaptureSink : public EventSink {
+    private:
+        std::shared_ptr<EventSink> inner;
+
+    public:
+        bool capturing = false;
+        std::vector<Trade> trades;
+
+        explicit FillCaptureSink(std::shared_ptr<EventSink> sink) : inner(std::move(sink)) {}
+
+        EventSink& get_inner() const { return *inner; }
+
+        void on_trade(const Trade& trade) override {
+            inner->on_trade(trade);
+            if (capturing) trades.push_back(trade);
+        }
+        void on_order_event(const OrderLog& log) override { inner->on_order_event(log); }
+
+        void flush() override { inner->flush(); }
+        void clear() override {
+            inner->clear();
+            trades.clear();
+        }
+};
+
 class Simulator {
     private:
+        std::shared_ptr<FillCaptureSink> fill_capture;
         OrderBook order_book;
         Timestamp simulation_time = 0;
-        std::map<TraderID, Order> pending_orders;
+
+        // Every order queued since the last submit, in arrival order (capacity is reused)
+        std::vector<Order> pending_orders;
+
+        // Sequencing of the pending orders
+        SequencingPolicy sequencing_policy = SequencingPolicy::FIFO;
+        std::mt19937_64 sequencing_rng;
+        Timestamp latency_jitter = 0;
+        std::unordered_map<TraderID, Timestamp> trader_latency;
+        std::vector<std::pair<Timestamp, std::uint32_t>> arrival_order;  // (arrival time, pending index)
+
+        // Native agents driven by run(), and who to tell about a fill
+        std::vector<std::shared_ptr<Agent>> agents;
+        std::unordered_map<TraderID, Agent*> agent_by_trader;
+
+        // Validate a batch order and queue it, for the *_batch entry points
+        SubmitStatus enqueue_batch_order(Order& order, std::uint8_t side_code, std::uint8_t type_code);
+        // Hand one pending order to the book
+        void submit_order(const Order& order);
 
     public:
-        Simulator(Timestamp start_time);
+        // A null event sink keeps every event in memory (MemorySink)
+        Simulator(Timestamp start_time, std::shared_ptr<EventSink> event_sink = nullptr);
+        // Opt in to the tick ladder book for this instrument
+        Simulator(Timestamp start_time, const LadderConfig& ladder_config, std::shared_ptr<EventSink> event_sink = nullptr);
 
         // Place orders
         void place_limit_order(PendingOrder pending_order);
         void place_market_order(PendingMarketOrder pending_market_order);
         std::vector<Order> get_all_trader_orders(TraderID trader_id) const;
 
+        // Columnar batch versions of the above: `count` orders read from parallel arrays
+        // (side codes 0 = BUY, 1 = SELL), one SubmitStatus written to `status` per order.
+        // `types` holds OrderType codes of the limit orders, nullptr means all LIMIT
+        void place_limit_orders_batch(const OrderID* order_ids, const TraderID* trader_ids, const Price* prices,
+                                      const Quantity* quantities, const std::uint8_t* sides, const std::uint8_t* types,
+                                      std::size_t count, SubmitStatus* status);
+        void place_market_orders_batch(const OrderID* order_ids, const TraderID* trader_ids,
+                                       const Quantity* quantities, const std::uint8_t* sides,
+                                       std::size_t count, SubmitStatus* status);
+        // Mixed batch in submission order: `types` holds any OrderType code, prices of MARKET rows are ignored
+        void place_orders_batch(const OrderID* order_ids, const TraderID* trader_ids, const Price* prices,
+                                const Quantity* quantities, const std::uint8_t* sides, const std::uint8_t* types,
+                                std::size_t count, SubmitStatus* status);
+
         void cancel_order(OrderID order_id);
         void modify_order(OrderID order_id, Price new_price, Quantity new_quantity);
 
-        // Submit orders into the orderbook, for now random by traders to simulate activity
+        // Submit every queued order into the orderbook, sequenced by the SequencingPolicy
         void submit_pending_orders();
+        std::size_t get_pending_order_count() const { return pending_orders.size(); }
+
+        // Pick the sequencing policy; reseeding makes SHUFFLE / LATENCY runs reproducible.
+        // latency_jitter is the upper bound of the random delay added per order in LATENCY mode
+        void set_sequencing_policy(SequencingPolicy policy, std::uint64_t seed = 0, Timestamp latency_jitter = 0);
+        SequencingPolicy get_sequencing_policy() const { return sequencing_policy; }
+        // Fixed delay of a trader's orders in LATENCY mode (default 0)
+        void set_trader_latency(TraderID trader_id, Timestamp latency);
 
         // Expose Market data
         Level1Data get_current_level1_data() const;
         Level2Data get_current_level2_data() const;
+        // Whether a `side` order limited to `price` would fill `quantity` right now (the FOK check)
+        bool can_fill(OrderSide side, Price price, Quantity quantity) const { return order_book.can_fill(side, price, quantity); }
         OrderBookSnapshot get_current_snapshot() const;
+        // Bounded depth written into caller-owned buffers, nothing is allocated
+        std::size_t copy_current_levels(OrderSide side, PriceLevel* out, std::size_t depth) const { return order_book.copy_levels(side, out, depth); }
+        template <std::size_t K>
+        void fill_current_depth(DepthN<K>& out) const { order_book.fill_depth(out); }
+        // Incremental Level 2: changed levels since a sequence instead of the full depth
+        void enable_level2_updates(std::size_t capacity = 1 << 16, std::uint64_t snapshot_interval = 0);
+        Level2Updates get_level2_updates(std::uint64_t since_sequence) const;
+        // Pre-size the book so that it does not allocate until it outgrows these sizes
+        void reserve(std::size_t orders, std::size_t levels) { order_book.reserve(orders, levels); }
+        // Per-operation latency and work counters of the book (only with ORDER_BOOK_ENGINE_STATS=1)
+        EngineStats get_engine_stats() const { return order_book.get_engine_stats(); }
+        void reset_engine_stats() { order_book.reset_engine_stats(); }
 
-        // Order and Trade logs
-        const std::vector<OrderLog>& get_order_logs() const { return order_book.order_logs; }
-        const std::vector<Trade>& get_trade_logs() const { return order_book.trade_logs; }
+        // Order and Trade logs still held by the event sink, from sequence `since` on
+        std::vector<OrderLog> get_order_logs(std::uint64_t since = 0) const { return get_event_sink().retained_order_logs(since); }
+        std::vector<Trade> get_trade_logs(std::uint64_t since = 0) const { return get_event_sink().retained_trades(since); }
+        EventSink& get_event_sink() const { return fill_capture->get_inner(); }
+
+        // Native agents: each tick of run() feeds them market data, submits their orders
+        // and reports fills, then advances time by time_step. Trader ids must be unique.
+        void add_agent(std::shared_ptr<Agent> agent);
+        const std::vector<std::shared_ptr<Agent>>& get_agents() const { return agents; }
+        void run(std::uint64_t n_ticks, Timestamp time_step = 1);
         
+        // Book validation (see InvariantMode)
+        void set_invariant_mode(InvariantMode mode, std::uint32_t sample_interval = 1024);
+        void validate_book() const;
+
         // Advance the simulation time
         void advance_time(Timestamp dt);
         Timestamp get_current_time() const;
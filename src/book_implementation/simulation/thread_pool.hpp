@@ -0,0 +1,112 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// =============================================
+// Thread Pool
+// =============================================
+
+/**
+ * Fixed set of worker threads running fork-join jobs.
+ *
+ * run(fn) calls fn(worker_index) once on every worker (the calling thread is worker 0) and
+ * returns when all of them are done, so callers shard their data by worker index and keep
+ * each shard on the same thread from job to job. The first exception thrown by a worker is
+ * rethrown from run().
+ */
+class ThreadPool {
+    private:
+        std::vector<std::thread> threads;
+
+        std::mutex mutex;
+        std::condition_variable job_ready;
+        std::condition_variable job_done;
+        const std::function<void(std::size_t)>* job = nullptr;
+        std::uint64_t generation = 0;
+        std::size_t running = 0;
+        bool stopping = false;
+        std::exception_ptr error;
+
+        void run_job(std::size_t worker_index) {
+            try {
+                (*job)(worker_index);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) error = std::current_exception();
+            }
+        }
+
+        void worker_loop(std::size_t worker_index) {
+            std::uint64_t seen = 0;
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    job_ready.wait(lock, [&] { return stopping || generation != seen; });
+                    if (stopping) return;
+                    seen = generation;
+                }
+                run_job(worker_index);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (--running == 0) job_done.notify_one();
+                }
+            }
+        }
+
+    public:
+        // 0 threads means one per hardware thread
+        explicit ThreadPool(std::size_t thread_count = 0) {
+            if (thread_count == 0) {
+                thread_count = std::thread::hardware_concurrency();
+            }
+            if (thread_count == 0) {
+                thread_count = 1;
+            }
+            for (std::size_t i = 1; i < thread_count; ++i) {
+                threads.emplace_back(&ThreadPool::worker_loop, this, i);
+            }
+        }
+
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            job_ready.notify_all();
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        std::size_t size() const { return threads.size() + 1; }
+
+        void run(const std::function<void(std::size_t)>& fn) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                job = &fn;
+                running = threads.size();
+                error = nullptr;
+                generation++;
+            }
+            job_ready.notify_all();
+            run_job(0);
+
+            std::unique_lock<std::mutex> lock(mutex);
+            job_done.wait(lock, [&] { return running == 0; });
+            job = nullptr;
+            if (error) {
+                std::exception_ptr rethrow = error;
+                error = nullptr;
+                std::rethrow_exception(rethrow);
+            }
+        }
+};
@@ -0,0 +1,84 @@
+#pragma once
+#include "thread_pool.hpp"
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// =============================================
+// Work-Stealing Pool
+// =============================================
+
+/**
+ * Runs many independent tasks of very different length across a ThreadPool.
+ *
+ * parallel_for(n, fn) deals the task indices round-robin into one deque per worker. A worker
+ * takes tasks from the back of its own deque and, once that is empty, steals from the front
+ * of the others, so a few long tasks cannot leave the remaining workers idle. Tasks are
+ * meant to be coarse (a whole simulation), so the deques are simply mutex protected.
+ */
+class WorkStealingPool {
+    private:
+        struct alignas(64) WorkQueue {
+            std::mutex mutex;
+            std::deque<std::size_t> tasks;
+        };
+
+        ThreadPool pool;
+        std::vector<std::unique_ptr<WorkQueue>> queues;
+
+        bool pop_own(std::size_t worker, std::size_t& task) {
+            WorkQueue& queue = *queues[worker];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) return false;
+            task = queue.tasks.back();
+            queue.tasks.pop_back();
+            return true;
+        }
+
+        bool steal(std::size_t thief, std::size_t& task) {
+            for (std::size_t offset = 1; offset < queues.size(); ++offset) {
+                WorkQueue& victim = *queues[(thief + offset) % queues.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.tasks.empty()) {
+                    task = victim.tasks.front();
+                    victim.tasks.pop_front();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    public:
+        // 0 threads means one per hardware thread
+        explicit WorkStealingPool(std::size_t thread_count = 0) : pool(thread_count) {
+            for (std::size_t i = 0; i < pool.size(); ++i) {
+                queues.push_back(std::make_unique<WorkQueue>());
+            }
+        }
+
+        std::size_t size() const { return pool.size(); }
+
+        // Call fn(task) for every task in [0, count); returns when all are done
+        void parallel_for(std::size_t count, const std::function<void(std::size_t)>& fn) {
+            for (std::size_t task = 0; task < count; ++task) {
+                queues[task % queues.size()]->tasks.push_back(task);
+            }
+            try {
+                pool.run([this, &fn](std::size_t worker) {
+                    std::size_t task;
+                    while (pop_own(worker, task) || steal(worker, task)) {
+                        fn(task);
+                    }
+                });
+            } catch (...) {
+                // A failed task leaves the rest of the work behind
+                for (auto& queue : queues) {
+                    queue->tasks.clear();
+                }
+                throw;
+            }
+        }
+};
@@ -13,7 +13,7 @@ class Agent(ABC):
         self.id_range : range = id_range
         self.used_ids : Set[int] = set()
 
-        self.data : MarketData = MarketData(snapshot=None, level1_data=None, level2_data=None)
+        self.data : MarketData = MarketData()
         self.submitted_trades : List[Any] = []
         self.trade_history : List[Any] = []
 
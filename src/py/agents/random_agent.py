@@ -29,7 +29,7 @@ class RandomAgent(Agent):
     def update(self, market_data: MarketData) -> None:
         # save market data
         self.data = market_data
-        incoming_mid: float = self.data.snapshot.mid_price if self.data.snapshot else 0.0
+        incoming_mid: float = self.data.level1_data.mid_price if self.data.level1_data else 0.0
         if incoming_mid > 0:
             self.mid_price = incoming_mid
         else:
@@ -2,6 +2,7 @@ from typing import List, Optional, Union
 
 from pydantic import BaseModel, ConfigDict
 import market_simulator
+from helper.level2_book import Level2Book
 
 
 class Orders(BaseModel):
@@ -10,6 +11,9 @@ class Orders(BaseModel):
 
 class MarketData(BaseModel):
     model_config = ConfigDict(arbitrary_types_allowed=True)
-    snapshot: Optional[market_simulator.OrderBookSnapshot]
-    level1_data: Optional[market_simulator.Level1Data]
-    level2_data: Optional[market_simulator.Level2Data]
\ No newline at end of file
+    # Full copies of the depth, O(depth) to build: only filled in on request, not every tick
+    snapshot: Optional[market_simulator.OrderBookSnapshot] = None
+    level1_data: Optional[market_simulator.Level1Data] = None
+    level2_data: Optional[market_simulator.Level2Data] = None
+    # Depth kept current from Level 2 deltas, the per-tick source of depth
+    level2_book: Optional[Level2Book] = None
\ No newline at end of file
@@ -0,0 +1,35 @@
+from typing import Dict, List, Tuple
+
+import market_simulator
+
+
+class Level2Book:
+    """Local copy of the book's depth, kept current from Simulator.get_level2_updates."""
+
+    def __init__(self) -> None:
+        self.sequence : int = 0
+        self.bids : Dict[float, int] = {}
+        self.asks : Dict[float, int] = {}
+
+    def sync(self, sim : market_simulator.Simulator) -> None:
+        """Apply the levels changed since the last sync (a full snapshot on the first call or after a resync)."""
+        result = sim.get_level2_updates(self.sequence)
+        if result.is_snapshot:
+            self.bids = {level.price: level.total_quantity for level in result.snapshot.bids}
+            self.asks = {level.price: level.total_quantity for level in result.snapshot.asks}
+        else:
+            for update in result.updates:
+                levels = self.bids if update.side == market_simulator.OrderSide.BUY else self.asks
+                if update.total_quantity == 0:
+                    levels.pop(update.price, None)
+                else:
+                    levels[update.price] = update.total_quantity
+        self.sequence = result.sequence
+
+    def bid_levels(self) -> List[Tuple[float, int]]:
+        """(price, quantity) pairs, best bid first"""
+        return sorted(self.bids.items(), reverse=True)
+
+    def ask_levels(self) -> List[Tuple[float, int]]:
+        """(price, quantity) pairs, best ask first"""
+        return sorted(self.asks.items())
@@ -1,12 +1,20 @@
+import numpy as np
 import market_simulator
 from helper.data_types import Orders
 
-def place_orders(sim : market_simulator.Simulator, orders : Orders):
-    for order in orders.orders:
-        if isinstance(order, market_simulator.PendingOrder):
-            sim.place_limit_order(order)
-        elif isinstance(order, market_simulator.PendingMarketOrder):
-            sim.place_market_order(order)
-        else:
-            raise ValueError("Unknown order type")
-       
\ No newline at end of file
+def place_orders(sim : market_simulator.Simulator, orders : Orders) -> np.ndarray:
+    # One call for the whole list: the order fields are read in C++ and the orders are queued
+    # in list order, so limit and market orders keep their arrival sequence
+    statuses : np.ndarray = sim.place_orders(orders.orders)
+
+    # Rejected orders are not queued; the accepted ones are, so raise only after the batch went in
+    rejected = np.flatnonzero(statuses != market_simulator.SubmitStatus.ACCEPTED.value)
+    if rejected.size > 0:
+        details = ", ".join(
+            f"order {orders.orders[i].order_id}: {market_simulator.SubmitStatus(int(statuses[i])).name}"
+            for i in rejected[:5]
+        )
+        more = f" (and {rejected.size - 5} more)" if rejected.size > 5 else ""
+        raise ValueError(f"{rejected.size} order(s) rejected: {details}{more}")
+
+    return statuses
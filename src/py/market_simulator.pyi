@@ -1,7 +1,9 @@
 """Type stubs for market_simulator C++ extension module."""
 
 from enum import Enum
-from typing import Any, Dict, List
+from typing import Any, Callable, Dict, List, Optional, Tuple, Union, overload
+
+import numpy as np
 
 class OrderSide(Enum):
     """Enumeration for order side (buy or sell)"""
@@ -12,6 +14,9 @@ class OrderType(Enum):
     """Enumeration for order type"""
     LIMIT = 0
     MARKET = 1
+    IOC = 2
+    FOK = 3
+    POST_ONLY = 4
 
 class OrderStatus(Enum):
     """Enumeration for order status"""
@@ -21,6 +26,50 @@ class OrderStatus(Enum):
     UNFILLED = 3
     CANCELED = 4
 
+class OrderEvent(Enum):
+    """Enumeration for order log events"""
+    LIMIT_PLACED = 0
+    TRADE_EXECUTED = 1
+    MARKET_EXECUTED = 2
+    NO_LIQUIDITY = 3
+    CANCELED = 4
+    MODIFIED = 5
+    PRICE_OUT_OF_BAND = 6
+    REMAINDER_CANCELED = 7
+    FOK_REJECTED = 8
+    POST_ONLY_REJECTED = 9
+
+class InvariantMode(Enum):
+    """How much book validation runs after each order"""
+    OFF = 0
+    CHEAP = 1
+    SAMPLED = 2
+    FULL = 3
+
+class EngineOp(Enum):
+    """Instrumented order book operation"""
+    PLACE_LIMIT = 0
+    PLACE_MARKET = 1
+    CANCEL = 2
+    MODIFY = 3
+    SNAPSHOT = 4
+    LEVEL1 = 5
+    LEVEL2 = 6
+
+class SubmitStatus(Enum):
+    """Per-order result of a batch submission"""
+    ACCEPTED = 0
+    INVALID_QUANTITY = 1
+    INVALID_PRICE = 2
+    INVALID_SIDE = 3
+    INVALID_TYPE = 4
+
+class SequencingPolicy(Enum):
+    """Order in which pending orders reach the book"""
+    FIFO = 0
+    SHUFFLE = 1
+    LATENCY = 2
+
 class PriceLevel:
     """Price level in the order book"""
     price: float
@@ -80,6 +129,100 @@ class Level2Data:
         """Convert to dictionary"""
         ...
 
+price_level_dtype: np.dtype
+"""Record layout of PriceLevel (price, total_quantity, order_count), for preallocated depth buffers"""
+
+class LevelUpdate:
+    """New state of one changed price level"""
+    sequence: int
+    """Sequence number of the change"""
+    timestamp: int
+    """Book time of the change"""
+    price: float
+    """Price of the level"""
+    total_quantity: int
+    """New total quantity, 0 = level removed"""
+    order_count: int
+    """New number of orders at the level"""
+    side: OrderSide
+    """Side of the level"""
+    
+    def __repr__(self) -> str:
+        """String representation of the level update"""
+        ...
+    
+    def to_dict(self) -> Dict[str, Any]:
+        """Convert to dictionary"""
+        ...
+
+class Level2Updates:
+    """Level 2 changes since a sequence, or a full snapshot to resync from"""
+    sequence: int
+    """Last change covered, pass it as since_sequence next time"""
+    is_snapshot: bool
+    """True if snapshot replaces the caller's book"""
+    snapshot: Level2Data
+    """Full depth (only when is_snapshot)"""
+    updates: List[LevelUpdate]
+    """Changed levels oldest first (only when not is_snapshot)"""
+    
+    def __repr__(self) -> str:
+        """String representation of Level2Updates"""
+        ...
+
+class DistributionSummary:
+    """Count, mean and percentiles of one recorded distribution"""
+    count: int
+    """Number of samples"""
+    min: int
+    """Smallest sample"""
+    mean: float
+    """Mean sample"""
+    p50: int
+    """Median"""
+    p90: int
+    """90th percentile"""
+    p99: int
+    """99th percentile"""
+    p999: int
+    """99.9th percentile"""
+    max: int
+    """Largest sample"""
+    
+    def to_dict(self) -> Dict[str, Any]:
+        """Convert to dictionary"""
+        ...
+
+class OperationStats:
+    """Instrumentation of one order book operation"""
+    operation: EngineOp
+    """Operation the counters belong to"""
+    ticks: DistributionSummary
+    """TSC ticks from entry to exit (divide by EngineStats.ticks_per_ns for ns)"""
+    fills: DistributionSummary
+    """Trades per call"""
+    levels_walked: DistributionSummary
+    """Distinct resting levels traded against per call"""
+    allocating_calls: int
+    """Calls that grew the book's order, index or level storage"""
+    
+    def __repr__(self) -> str:
+        """String representation of OperationStats"""
+        ...
+
+class EngineStats:
+    """Per-operation latency and work counters of an order book"""
+    enabled: bool
+    """False unless the module was built with ORDER_BOOK_ENGINE_STATS=1"""
+    ticks_per_ns: float
+    """TSC ticks per nanosecond"""
+    operations: List[OperationStats]
+    """One entry per EngineOp, in enum order"""
+    
+    def __repr__(self) -> str:
+        """String representation of EngineStats"""
+        ...
+
 class OrderBookSnapshot:
     """Full order book snapshot"""
     timestamp: int
@@ -152,8 +295,10 @@ class OrderLog:
     """Current status of the order"""
     timestamp: int
     """Timestamp of the log entry"""
+    event: OrderEvent
+    """Event code of the order event"""
     details: str
-    """Additional details about the order event"""
+    """Additional details about the order event (rendered from the event code)"""
     
     def __repr__(self) -> str:
         """String representation of OrderLog"""
@@ -192,6 +337,34 @@ class TradeLog:
         """Convert to dictionary"""
         ...
 
+class LadderConfig:
+    """Tick size and price band for a tick ladder order book"""
+    tick_size: float
+    """Minimum price increment"""
+    min_price: float
+    """Lowest price accepted by the book"""
+    max_price: float
+    """Highest price accepted by the book"""
+
+    def __init__(self, tick_size: float = 0.01, min_price: float = 0.01, max_price: float = 1000.0) -> None:
+        """
+        Create a ladder configuration
+
+        Args:
+            tick_size: Minimum price increment
+            min_price: Lowest price accepted by the book
+            max_price: Highest price accepted by the book
+        """
+        ...
+
+    def __repr__(self) -> str:
+        """String representation of LadderConfig"""
+        ...
+
+    def to_dict(self) -> Dict[str, Any]:
+        """Convert to dictionary"""
+        ...
+
 class PendingOrder:
     """Structure representing a pending order"""
     order_id: int
@@ -204,6 +377,8 @@ class PendingOrder:
     """Number of shares/contracts"""
     side: OrderSide
     """Order side (BUY or SELL)"""
+    type: OrderType
+    """LIMIT, IOC, FOK or POST_ONLY"""
     
     def __init__(
         self,
@@ -211,7 +386,8 @@ class PendingOrder:
         trader_id: int,
         price: float,
         quantity: int,
-        side: OrderSide
+        side: OrderSide,
+        type: OrderType = OrderType.LIMIT
     ) -> None:
         """
         Create a pending limit order
@@ -222,6 +398,10 @@ class PendingOrder:
             price: Limit price for the order
             quantity: Number of shares/contracts
             side: BUY or SELL
+            type: LIMIT (rest the remainder), IOC (cancel the remainder), FOK (all or nothing) or POST_ONLY (never trade on entry)
+        
+        Raises:
+            ValueError: If type is MARKET
         """
         ...
     
@@ -270,15 +450,143 @@ class PendingMarketOrder:
         """Convert to dictionary"""
         ...
 
+class EventSink:
+    """Destination for trade and order events"""
+
+class NullSink(EventSink):
+    """Event sink that drops every event"""
+    def __init__(self) -> None: ...
+
+class MemorySink(EventSink):
+    """Event sink that keeps every event in memory (default)"""
+    def __init__(self) -> None: ...
+
+class RingSink(EventSink):
+    """Event sink that keeps the most recent N events"""
+    def __init__(self, trade_capacity: int, order_log_capacity: int) -> None: ...
+
+class BinaryFileSink(EventSink):
+    """Event sink that streams records to binary files"""
+    def __init__(self, trade_path: str, order_path: str) -> None: ...
+
+class CallbackSink(EventSink):
+    """Event sink that forwards events to Python callables"""
+    def __init__(
+        self,
+        on_trade: Optional[Callable[[TradeLog], None]] = None,
+        on_order_event: Optional[Callable[[OrderLog], None]] = None
+    ) -> None: ...
+
+class TradeJournal:
+    """Memory-mapped trade journal file written by BinaryFileSink"""
+    def __init__(self, path: str) -> None: ...
+    def __len__(self) -> int: ...
+    def __getitem__(self, index: int) -> TradeLog: ...
+    def to_numpy(self) -> np.ndarray:
+        """Zero-copy NumPy structured array over all records (sequence + trade fields)"""
+        ...
+
+class OrderJournal:
+    """Memory-mapped order event journal file written by BinaryFileSink"""
+    def __init__(self, path: str) -> None: ...
+    def __len__(self) -> int: ...
+    def __getitem__(self, index: int) -> OrderLog: ...
+    def to_numpy(self) -> np.ndarray:
+        """Zero-copy NumPy structured array over all records (sequence + order log fields)"""
+        ...
+
+class Agent:
+    """Native trading agent driven by Simulator.run"""
+    @property
+    def trader_id(self) -> int:
+        """Identifier of the trader"""
+        ...
+
+class RandomAgent(Agent):
+    """Native agent placing random limit orders around the mid price"""
+    def __init__(
+        self,
+        trader_id: int,
+        first_order_id: int,
+        last_order_id: int,
+        seed: int = 0,
+        trading_probability: float = 0.35,
+        min_price: float = 0.01
+    ) -> None:
+        """
+        Create a random agent
+        
+        Args:
+            trader_id: Identifier of the trader
+            first_order_id: First order id of the agent's id range
+            last_order_id: End (exclusive) of the agent's id range
+            seed: Seed of the agent's random generator
+            trading_probability: Chance to trade each tick
+            min_price: Lowest price the agent will quote
+        """
+        ...
+
+class MarketMakerAgent(Agent):
+    """Native agent quoting both sides around the mid price"""
+    def __init__(
+        self,
+        trader_id: int,
+        first_order_id: int,
+        last_order_id: int,
+        half_spread: float = 0.05,
+        quote_quantity: int = 10,
+        max_inventory: int = 100,
+        inventory_skew: float = 0.0,
+        initial_price: float = 10.0
+    ) -> None:
+        """
+        Create a market maker agent
+        
+        Args:
+            trader_id: Identifier of the trader
+            first_order_id: First order id of the agent's id range
+            last_order_id: End (exclusive) of the agent's id range
+            half_spread: Distance of each quote from the mid price
+            quote_quantity: Quantity of each quote
+            max_inventory: Stop quoting a side beyond this position
+            inventory_skew: Quote shift per unit of inventory
+            initial_price: Reference price until the book has a mid
+        """
+        ...
+
+    @property
+    def inventory(self) -> int:
+        """Current position"""
+        ...
+
+    @property
+    def cash(self) -> float:
+        """Cash from all fills"""
+        ...
+
 class Simulator:
     """Order book market simulator"""
     
-    def __init__(self, start_time: int = 0) -> None:
+    @overload
+    def __init__(self, start_time: int = 0, sink: Optional[EventSink] = None) -> None:
         """
         Initialize the simulator with an optional start time
         
         Args:
             start_time: Simulation start timestamp (default is 0)
+            sink: Destination of trade/order events (default MemorySink)
+        """
+        ...
+
+    @overload
+    def __init__(self, start_time: int, ladder: LadderConfig, sink: Optional[EventSink] = None) -> None:
+        """
+        Initialize the simulator with a tick ladder order book
+
+        Args:
+            start_time: Simulation start timestamp
+            ladder: Tick size and price band of the book
+            sink: Destination of trade/order events (default MemorySink)
         """
         ...
     
@@ -287,7 +595,7 @@ class Simulator:
         Place a limit order into the order book
         
         Args:
-            pending_order: The pending limit order to place
+            pending_order: The pending limit order to place, its type picks LIMIT, IOC, FOK or POST_ONLY
         """
         ...
     
@@ -299,7 +607,122 @@ class Simulator:
             pending_market_order: The pending market order to place
         """
         ...
+
+    def place_limit_orders_batch(
+        self,
+        order_ids: np.ndarray,
+        trader_ids: np.ndarray,
+        prices: np.ndarray,
+        quantities: np.ndarray,
+        sides: np.ndarray,
+        types: Optional[np.ndarray] = None
+    ) -> np.ndarray:
+        """
+        Queue many limit orders at once from NumPy arrays
+        
+        Args:
+            order_ids: Unique identifiers of the orders (uint64)
+            trader_ids: Identifiers of the traders (uint64)
+            prices: Limit prices (float64)
+            quantities: Number of shares/contracts (uint32)
+            sides: Side codes, 0 = BUY, 1 = SELL (uint8)
+            types: OrderType codes LIMIT, IOC, FOK or POST_ONLY (uint8), all LIMIT if omitted.
+                MARKET or unknown codes are rejected with INVALID_TYPE
+        
+        Returns:
+            One SubmitStatus code (uint8) per order
+        """
+        ...
+
+    def place_market_orders_batch(
+        self,
+        order_ids: np.ndarray,
+        trader_ids: np.ndarray,
+        quantities: np.ndarray,
+        sides: np.ndarray
+    ) -> np.ndarray:
+        """
+        Queue many market orders at once from NumPy arrays
+        
+        Args:
+            order_ids: Unique identifiers of the orders (uint64)
+            trader_ids: Identifiers of the traders (uint64)
+            quantities: Number of shares/contracts (uint32)
+            sides: Side codes, 0 = BUY, 1 = SELL (uint8)
+        
+        Returns:
+            One SubmitStatus code (uint8) per order
+        """
+        ...
+
+    def place_orders_batch(
+        self,
+        order_ids: np.ndarray,
+        trader_ids: np.ndarray,
+        prices: np.ndarray,
+        quantities: np.ndarray,
+        sides: np.ndarray,
+        types: np.ndarray
+    ) -> np.ndarray:
+        """
+        Queue a mix of limit and market orders at once from NumPy arrays, in array order
+        
+        Args:
+            order_ids: Unique identifiers of the orders (uint64)
+            trader_ids: Identifiers of the traders (uint64)
+            prices: Limit prices, ignored for market orders (float64)
+            quantities: Number of shares/contracts (uint32)
+            sides: Side codes, 0 = BUY, 1 = SELL (uint8)
+            types: OrderType codes, MARKET included (uint8)
+        
+        Returns:
+            One SubmitStatus code (uint8) per order
+        """
+        ...
+
+    def place_orders(self, orders: List[Union[PendingOrder, PendingMarketOrder]]) -> np.ndarray:
+        """
+        Queue a list of PendingOrder and PendingMarketOrder objects in one call, in list order
+        
+        Args:
+            orders: Orders to queue
+        
+        Returns:
+            One SubmitStatus code (uint8) per order, in list order
+        """
+        ...
     
+    def add_agent(self, agent: Agent) -> None:
+        """
+        Register a native agent to be driven by run()
+        
+        Args:
+            agent: Agent with a trader id not used by any other agent
+        """
+        ...
+
+    def get_agents(self) -> List[Agent]:
+        """
+        Get the registered native agents
+        
+        Returns:
+            Agents in registration order
+        """
+        ...
+
+    def run(self, n_ticks: int, time_step: int = 1) -> None:
+        """
+        Run the native agents for n_ticks entirely in C++, without holding the GIL
+        
+        Each tick feeds every agent the top of book, submits their orders,
+        reports fills back to them and advances time by time_step
+        
+        Args:
+            n_ticks: Number of ticks to run
+            time_step: Time advanced after each tick
+        """
+        ...
+
     def get_all_trader_orders(self, trader_id: int) -> List[Order]:
         """
         Get all orders for a specific trader
@@ -324,6 +747,9 @@ class Simulator:
     def modify_order(self, order_id: int, new_price: float, new_quantity: int) -> None:
         """
         Modify an existing order's price and/or quantity
+
+        A quantity decrease at the same price keeps queue priority,
+        any other change requeues the order
         
         Args:
             order_id: Unique identifier of the order to modify
@@ -336,7 +762,38 @@ class Simulator:
         """
         Submit all pending orders to the order book
         
-        Processes queued orders and matches them against the book
+        Processes queued orders, in the order chosen by the SequencingPolicy,
+        and matches them against the book
+        """
+        ...
+
+    def get_pending_order_count(self) -> int:
+        """
+        Get the number of orders waiting for submit_pending_orders
+        
+        Returns:
+            Number of queued orders
+        """
+        ...
+
+    def set_sequencing_policy(self, policy: SequencingPolicy, seed: int = 0, latency_jitter: int = 0) -> None:
+        """
+        Choose the order in which submit_pending_orders hands orders to the book
+        
+        Args:
+            policy: Sequencing policy
+            seed: Seed of the SHUFFLE / LATENCY random generator
+            latency_jitter: Maximum random delay added per order in LATENCY mode
+        """
+        ...
+
+    def set_trader_latency(self, trader_id: int, latency: int) -> None:
+        """
+        Set the fixed delay of a trader's orders in LATENCY mode
+        
+        Args:
+            trader_id: Identifier of the trader
+            latency: Delay added to the trader's arrival time
         """
         ...
     
@@ -358,6 +815,80 @@ class Simulator:
         """
         ...
     
+    def can_fill(self, side: OrderSide, price: float, quantity: int) -> bool:
+        """
+        Check whether an order could fill completely right now, without changing the book
+        
+        Args:
+            side: Side of the incoming order
+            price: Limit price of the incoming order
+            quantity: Quantity that has to be available
+        
+        Returns:
+            True if the other side holds quantity at prices up to (or down to) price
+        """
+        ...
+    
+    def get_depth_into(self, bids: np.ndarray, asks: np.ndarray) -> Tuple[int, int]:
+        """
+        Write the best levels into preallocated arrays, nothing is allocated per call
+        
+        Args:
+            bids: price_level_dtype array, its length is the bid depth
+            asks: price_level_dtype array, its length is the ask depth
+        
+        Returns:
+            Number of bid and ask levels written (best first)
+        """
+        ...
+    
+    def enable_level2_updates(self, capacity: int = 65536, snapshot_interval: int = 0) -> None:
+        """
+        Start logging changed price levels for get_level2_updates
+        
+        Args:
+            capacity: Changes kept for readers that fall behind (rounded up to a power of two)
+            snapshot_interval: Send a full snapshot whenever a reader crosses a multiple of this sequence, 0 = never
+        """
+        ...
+    
+    def get_level2_updates(self, since_sequence: int) -> Level2Updates:
+        """
+        Get the price levels changed since a sequence
+        
+        Args:
+            since_sequence: Sequence of the previous answer, 0 for a first full snapshot
+        
+        Returns:
+            Changes in order, or a full snapshot when the caller has to resync
+        """
+        ...
+    
+    def reserve(self, orders: int, levels: int) -> None:
+        """
+        Pre-size the book's order store, order index and price level pools
+        
+        Args:
+            orders: Resting orders to make room for
+            levels: Price levels per side to make room for
+        """
+        ...
+    
+    def get_engine_stats(self) -> EngineStats:
+        """
+        Get per-operation TSC latency, fills, levels walked and allocating calls of the book
+        
+        Returns:
+            Counters since the last reset, enabled is False when compiled out
+        """
+        ...
+    
+    def reset_engine_stats(self) -> None:
+        """
+        Clear the engine stats counters and histograms
+        """
+        ...
+    
     def get_current_snapshot(self) -> OrderBookSnapshot:
         """
         Get full order book snapshot
@@ -367,6 +898,25 @@ class Simulator:
         """
         ...
     
+    def set_invariant_mode(self, mode: InvariantMode, sample_interval: int = 1024) -> None:
+        """
+        Choose how much book validation runs after each order
+
+        Args:
+            mode: Validation mode
+            sample_interval: Order events between full scans in SAMPLED mode
+        """
+        ...
+
+    def validate_book(self) -> None:
+        """
+        Run a full validation pass over the order book
+
+        Raises:
+            RuntimeError: If an invariant is violated
+        """
+        ...
+
     def advance_time(self, dt: int) -> None:
         """
         Advance simulation time by dt
@@ -385,20 +935,327 @@ class Simulator:
         """
         ...
     
-    def get_order_logs(self) -> List[OrderLog]:
+    def get_order_logs(self, since: int = 0) -> List[OrderLog]:
         """
         Get the order logs
         
+        Args:
+            since: Only return entries with this sequence number or later
+        
         Returns:
-            List of all order log entries
+            Order log entries held by the event sink
         """
         ...
     
-    def get_trade_logs(self) -> List[TradeLog]:
+    def get_trade_logs(self, since: int = 0) -> List[TradeLog]:
         """
         Get the trade logs
         
+        Args:
+            since: Only return entries with this sequence number or later
+        
+        Returns:
+            Trade log entries held by the event sink
+        """
+        ...
+
+    def get_order_logs_array(self, since: int = 0) -> np.ndarray:
+        """
+        Get the order logs as a NumPy structured array
+        
+        With the default MemorySink the array is usually a read-only view without any copy.
+        The view is only valid until the book or its event sink is cleared: clear() reuses the
+        storage, so later records show through. Copy it (np.array(view)) to keep it longer
+        
+        Args:
+            since: Only return entries with this sequence number or later
+        
+        Returns:
+            One record per order log entry
+        """
+        ...
+
+    def get_trade_logs_array(self, since: int = 0) -> np.ndarray:
+        """
+        Get the trade logs as a NumPy structured array
+        
+        With the default MemorySink the array is usually a read-only view without any copy.
+        The view is only valid until the book or its event sink is cleared: clear() reuses the
+        storage, so later records show through. Copy it (np.array(view)) to keep it longer
+        
+        Args:
+            since: Only return trades with this sequence number or later
+        
         Returns:
-            List of all trade log entries
+            One record per trade
+        """
+        ...
+
+    def get_order_log_sequence(self) -> int:
+        """
+        Sequence number the next order log entry will get
+        
+        Pass it as `since` on the next poll to fetch only new entries
+        """
+        ...
+
+    def get_trade_sequence(self) -> int:
+        """
+        Sequence number the next trade will get
+        
+        Pass it as `since` on the next poll to fetch only new trades
+        """
+        ...
+
+    def flush_events(self) -> None:
+        """
+        Flush buffered events of the event sink (e.g. BinaryFileSink) to their destination
+        """
+        ...
+
+
+class MultiBookSimulator:
+    """Independent order books per instrument, matched in parallel"""
+    def __init__(
+        self,
+        num_books: int,
+        num_threads: int = 0,
+        ladder: Optional[LadderConfig] = None,
+        invariant_mode: InvariantMode = ...,
+        start_time: int = 0
+    ) -> None:
         """
+        Initialize one order book per instrument
+        
+        Args:
+            num_books: Number of instruments (ids 0 .. num_books - 1)
+            num_threads: Worker threads, 0 = one per hardware thread
+            ladder: Use tick ladder books with this configuration
+            invariant_mode: Validation mode of every book
+            start_time: Simulation start timestamp
+        """
+        ...
+
+    @property
+    def num_books(self) -> int:
+        """Number of instruments"""
+        ...
+
+    @property
+    def num_threads(self) -> int:
+        """Number of worker threads"""
+        ...
+
+    def place_limit_order(self, instrument: int, pending_order: PendingOrder) -> None:
+        """Queue a limit order for one instrument"""
+        ...
+
+    def place_market_order(self, instrument: int, pending_market_order: PendingMarketOrder) -> None:
+        """Queue a market order for one instrument"""
+        ...
+
+    def cancel_order(self, instrument: int, order_id: int) -> None:
+        """Cancel an existing order of one instrument"""
+        ...
+
+    def modify_order(self, instrument: int, order_id: int, new_price: float, new_quantity: int) -> None:
+        """Modify an existing order of one instrument"""
+        ...
+
+    def submit_pending_orders(self) -> None:
+        """Match the pending orders of every book in parallel, without holding the GIL"""
+        ...
+
+    def get_level1_data(self, instrument: int) -> Level1Data:
+        """Get top of book data of one instrument"""
+        ...
+
+    def get_level2_data(self, instrument: int) -> Level2Data:
+        """Get Level 2 market data of one instrument"""
+        ...
+
+    def get_all_level1_data(self) -> List[Level1Data]:
+        """Get top of book data of every instrument"""
+        ...
+
+    def get_trade_logs(self) -> List[Tuple[int, TradeLog]]:
+        """Get the trades of all books as (instrument, trade) pairs, merged in a thread-count independent order"""
+        ...
+
+    def get_order_logs(self) -> List[Tuple[int, OrderLog]]:
+        """Get the order logs of all books as (instrument, order log) pairs, merged in a thread-count independent order"""
+        ...
+
+    def get_book_trade_logs(self, instrument: int) -> List[TradeLog]:
+        """Get the trades of one instrument"""
+        ...
+
+    def get_book_order_logs(self, instrument: int) -> List[OrderLog]:
+        """Get the order logs of one instrument"""
+        ...
+
+    def advance_time(self, dt: int) -> None:
+        """Advance simulation time of every book by dt"""
+        ...
+
+    def get_current_time(self) -> int:
+        """Get the current simulation time"""
+        ...
+
+
+class ScenarioSpec:
+    """Scenario run by every replica of run_monte_carlo"""
+    n_ticks: int
+    """Ticks per replica"""
+    time_step: int
+    """Time advanced per tick"""
+    ladder: Optional[LadderConfig]
+    """Tick ladder configuration, None for the map book"""
+    invariant_mode: InvariantMode
+    """Validation mode of each replica's book"""
+    initial_bid: float
+    """Opening bid price"""
+    initial_ask: float
+    """Opening ask price"""
+    initial_quantity: int
+    """Quantity of the opening quotes"""
+    num_random_agents: int
+    """Number of RandomAgents"""
+    trading_probability: float
+    """Default chance of a RandomAgent to trade each tick"""
+    market_maker: bool
+    """Add a MarketMakerAgent"""
+    half_spread: float
+    """Default half spread of the market maker"""
+    quote_quantity: int
+    """Quantity of each market maker quote"""
+    max_inventory: int
+    """Inventory limit of the market maker"""
+    inventory_skew: float
+    """Default inventory skew of the market maker"""
+
+    def __init__(self) -> None: ...
+
+def run_monte_carlo(
+    spec: ScenarioSpec,
+    seeds: np.ndarray,
+    trading_probability: Optional[np.ndarray] = None,
+    half_spread: Optional[np.ndarray] = None,
+    inventory_skew: Optional[np.ndarray] = None,
+    num_threads: int = 0
+) -> np.ndarray:
+    """
+    Run independent replicas of a scenario in parallel, entirely in C++
+    
+    Replicas run on a work-stealing thread pool without holding the GIL
+    
+    Args:
+        spec: Scenario shared by all replicas
+        seeds: One seed per replica (uint64)
+        trading_probability: Per-replica RandomAgent trading probability
+        half_spread: Per-replica market maker half spread
+        inventory_skew: Per-replica market maker inventory skew
+        num_threads: Worker threads, 0 = one per hardware thread
+    
+    Returns:
+        One structured record per replica (seed, trade_count, volume, vwap, spread_samples,
+        spread_mean, spread_std, spread_p5, spread_p50, spread_p95, final_mid,
+        final_inventory, final_cash), in seed order
+    """
+    ...
+
+
+class MatchingEngine:
+    """Order book matched on its own thread behind lock-free rings"""
+    def __init__(
+        self,
+        command_capacity: int = 65536,
+        event_capacity: int = 262144,
+        batch_size: int = 256,
+        cpu: int = -1,
+        ladder: Optional[LadderConfig] = None
+    ) -> None:
+        """
+        Create a stopped matching engine
+        
+        Args:
+            command_capacity: Slots of the order command ring
+            event_capacity: Slots of the trade/order event ring
+            batch_size: Commands matched per batch
+            cpu: Core to pin the matching thread to (Linux), -1 = no pinning
+            ladder: Use a tick ladder book with this configuration
+        """
+        ...
+
+    def start(self) -> None:
+        """Start the matching thread"""
+        ...
+
+    def stop(self) -> None:
+        """Match every submitted command, then stop the matching thread"""
+        ...
+
+    @property
+    def running(self) -> bool:
+        """Whether the matching thread runs"""
+        ...
+
+    @property
+    def failed(self) -> bool:
+        """Whether a command made the book throw; submits then raise and stop() rethrows the error"""
+        ...
+
+    def submit_limit_order(self, pending_order: PendingOrder, timestamp: int = 0) -> None:
+        """Queue a limit, IOC, FOK or post-only order for the matching thread"""
+        ...
+
+    def submit_market_order(self, pending_market_order: PendingMarketOrder, timestamp: int = 0) -> None:
+        """Queue a market order for the matching thread"""
+        ...
+
+    def submit_cancel(self, order_id: int) -> None:
+        """Queue a cancel for the matching thread"""
+        ...
+
+    def submit_modify(self, order_id: int, new_price: float, new_quantity: int) -> None:
+        """Queue a modify for the matching thread"""
+        ...
+
+    def poll_events(self, max_events: int = 0) -> Tuple[List[TradeLog], List[OrderLog]]:
+        """
+        Take the trades and order events published so far
+        
+        Args:
+            max_events: Stop after this many events, 0 = all waiting
+        
+        Returns:
+            Trades and order logs in publication order
+        """
+        ...
+
+    @property
+    def processed_commands(self) -> int:
+        """Commands matched so far"""
+        ...
+
+    @property
+    def dropped_events(self) -> int:
+        """Events dropped at shutdown because nobody polled"""
+        ...
+
+    def get_level1_data(self) -> Level1Data:
+        """Get top of book data (only while stopped)"""
+        ...
+
+    def get_published_level1(self) -> Level1Data:
+        """Top of book as of the last matched batch, readable while the engine runs"""
+        ...
+
+    def get_published_level2(self) -> Level2Data:
+        """Best levels per side as of the last matched batch, readable while the engine runs"""
+        ...
+
+    @property
+    def published_version(self) -> int:
+        """Number of market data publications so far"""
         ...
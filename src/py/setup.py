@@ -1,3 +1,4 @@
+import os
 import sys
 from setuptools import setup, Extension
 import pybind11
@@ -14,12 +15,17 @@ if sys.platform == "win32" and "MSC" in sys.version and not is_mingw:
     extra_compile_args = ['/std:c++17']
     extra_link_args = []
 else:
-    extra_compile_args = ['-std=c++17', '-O3']
+    extra_compile_args = ['-std=c++17', '-O3', '-pthread']
     if is_mingw:
         # Static link all runtime libraries
         extra_link_args = ['-static']
     else:
-        extra_link_args = []
+        extra_link_args = ['-pthread']
+
+# Simulator.get_engine_stats() only reports data when the instrumentation is compiled in
+define_macros = []
+if os.environ.get('ORDER_BOOK_ENGINE_STATS') == '1':
+    define_macros.append(('ORDER_BOOK_ENGINE_STATS', '1'))
 
 ext_modules = [
     Extension(
@@ -27,13 +33,20 @@ ext_modules = [
         [
             '../book_implementation/simulation/python_bindings.cpp',
             '../book_implementation/simulation/simulator.cpp', 
-            '../book_implementation/order_book/order_book.cpp'
+            '../book_implementation/simulation/multi_book_simulator.cpp',
+            '../book_implementation/simulation/batch_runner.cpp',
+            '../book_implementation/simulation/agents/random_agent.cpp',
+            '../book_implementation/simulation/agents/market_maker_agent.cpp',
+            '../book_implementation/order_book/order_book.cpp',
+            '../book_implementation/order_book/journal_file.cpp',
+            '../book_implementation/order_book/matching_engine.cpp'
         ],
         include_dirs=[
             pybind11.get_include(), 
             '../book_implementation'
         ],
         language='c++',
+        define_macros=define_macros,
         extra_compile_args=extra_compile_args,
         extra_link_args=extra_link_args,
     ),
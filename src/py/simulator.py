@@ -1,6 +1,7 @@
 import market_simulator
 from helper.data_types import Orders, MarketData
 from helper.place_orders import place_orders
+from helper.level2_book import Level2Book
 from typing import List
 from agents import (random_agent)
 from agents.agent import Agent
@@ -12,6 +13,13 @@ from agents.agent import Agent
 # Initialize the market simulator
 sim : market_simulator.Simulator = market_simulator.Simulator(start_time = 0)
 
+# Process each tick's orders in a random, but reproducible, arrival order
+sim.set_sequencing_policy(market_simulator.SequencingPolicy.SHUFFLE, seed=42)
+
+# Keep depth current from changed levels instead of copying the whole book every tick
+sim.enable_level2_updates()
+level2_book : Level2Book = Level2Book()
+
 # Create some initial orders to seed the market
 initial_orders : Orders = Orders(orders=
 [
@@ -54,10 +62,10 @@ def main():
     while sim.get_current_time() < run_time:
 
         # Gather market data for each tick
+        level2_book.sync(sim)
         market_data : MarketData = MarketData(
-            snapshot=sim.get_current_snapshot(),
             level1_data=sim.get_current_level1_data(),
-            level2_data=sim.get_current_level2_data()
+            level2_book=level2_book
         )
 
         # Let each agent update their state and decide on trades
@@ -71,7 +79,7 @@ def main():
             # Place orders into the simulator queue
             place_orders(sim, orders)
         
-        # Let simulator process orders (randomly chooses which trader to process first)
+        # Let simulator process orders (in the seeded random order chosen above)
         sim.submit_pending_orders()
         sim.advance_time(time_step)
 
@@ -0,0 +1,235 @@
+#include "order_book/order_book.hpp"
+#include "order_book/order_index.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// =========================================================================
+// OrderBook Tests
+// =========================================================================
+//
+// Plain self-checking executable run by ctest: every check that fails prints its line and
+// the process exits non-zero. Book tests run against both book variants (std::map levels
+// and the tick ladder) with full invariant checks after every event.
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(condition)                                                                    \
+    do {                                                                                    \
+        if (!(condition)) {                                                                 \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            failures++;                                                                     \
+        }                                                                                   \
+    } while (0)
+
+const LadderConfig LADDER{0.01, 0.01, 200.0};
+
+enum class BookKind { MAP, LADDER };
+
+struct TestBook {
+    std::shared_ptr<MemorySink> sink = std::make_shared<MemorySink>();
+    std::unique_ptr<OrderBook> book;
+
+    explicit TestBook(BookKind kind)
+        : book(kind == BookKind::LADDER ? std::make_unique<OrderBook>(LADDER, sink)
+                                        : std::make_unique<OrderBook>(sink)) {
+        book->set_invariant_mode(InvariantMode::FULL);
+    }
+
+    OrderBook* operator->() { return book.get(); }
+
+    std::vector<Trade> trades() const { return sink->retained_trades(); }
+    std::vector<OrderLog> logs() const { return sink->retained_order_logs(); }
+
+    // Order logs of one order with the given event
+    std::size_t count_events(OrderID order_id, OrderEvent event) const {
+        std::size_t n = 0;
+        for (const OrderLog& log : logs()) {
+            if (log.order_id == order_id && log.event == event) {
+                n++;
+            }
+        }
+        return n;
+    }
+};
+
+Order make_order(OrderID order_id, OrderSide side, Price price, Quantity quantity,
+                 OrderType type = OrderType::LIMIT) {
+    return Order{order_id, order_id * 10, price, quantity, side, type, static_cast<Timestamp>(order_id)};
+}
+
+// -------------------------------------------------------------------------
+// OrderIndex
+// -------------------------------------------------------------------------
+
+// Keys sharing one home slot form a single probe run; erasing from the middle must shift the
+// rest of the run back so every remaining key is still found
+void test_order_index_backward_shift_erase() {
+    OrderIndex index(8);  // 16 slots
+    CHECK(index.capacity() == 16);
+
+    // Home slot is the top 4 bits of the Fibonacci product, see OrderIndex::home()
+    auto home = [](OrderID key) { return (key * 0x9E3779B97F4A7C15ULL) >> 60; };
+    std::vector<OrderID> run;
+    for (OrderID key = 1; run.size() < 5; key++) {
+        if (home(key) == home(1)) {
+            run.push_back(key);
+        }
+    }
+    for (std::size_t i = 0; i < run.size(); i++) {
+        index.insert(run[i], static_cast<NodeHandle>(i));
+    }
+
+    CHECK(index.erase(run[1]));
+    CHECK(!index.erase(run[1]));
+    CHECK(index.find(run[1]) == NULL_NODE);
+    CHECK(index.size() == run.size() - 1);
+    for (std::size_t i = 0; i < run.size(); i++) {
+        if (i != 1) {
+            CHECK(index.find(run[i]) == static_cast<NodeHandle>(i));
+        }
+    }
+
+    CHECK(index.erase(run[0]));
+    CHECK(index.erase(run[4]));
+    CHECK(index.find(run[2]) == 2);
+    CHECK(index.find(run[3]) == 3);
+}
+
+// Random insert/erase churn on a small table against std::unordered_map, so runs wrap
+// around the end of the slot array and get erased in every position
+void test_order_index_churn() {
+    OrderIndex index(16);
+    std::unordered_map<OrderID, NodeHandle> expected;
+    std::mt19937_64 rng(7);
+
+    for (int step = 0; step < 200000; step++) {
+        OrderID key = rng() % 64;
+        if (rng() % 2 == 0) {
+            NodeHandle value = static_cast<NodeHandle>(step);
+            index.insert(key, value);
+            expected[key] = value;
+        } else {
+            CHECK(index.erase(key) == (expected.erase(key) == 1));
+        }
+    }
+
+    CHECK(index.size() == expected.size());
+    for (OrderID key = 0; key < 64; key++) {
+        auto it = expected.find(key);
+        CHECK(index.find(key) == (it == expected.end() ? NULL_NODE : it->second));
+    }
+}
+
+// -------------------------------------------------------------------------
+// OrderBook
+// -------------------------------------------------------------------------
+
+// Reducing a resting order at the same price keeps its place in the queue; a larger
+// quantity sends it to the back of the level
+void test_modify_queue_position(BookKind kind) {
+    TestBook book(kind);
+    book->place_limit_order(make_order(1, OrderSide::SELL, 100.00, 10));
+    book->place_limit_order(make_order(2, OrderSide::SELL, 100.00, 10));
+
+    book->modify_order(1, 100.00, 5);
+    CHECK(book.count_events(1, OrderEvent::MODIFIED) == 1);
+    book->place_market_order(make_order(3, OrderSide::BUY, 0, 5, OrderType::MARKET));
+
+    std::vector<Trade> trades = book.trades();
+    CHECK(trades.size() == 1);
+    CHECK(!trades.empty() && trades[0].sell_order_id == 1 && trades[0].quantity == 5);
+
+    book->place_limit_order(make_order(4, OrderSide::SELL, 100.00, 10));
+    book->modify_order(2, 100.00, 20);
+    book->place_market_order(make_order(5, OrderSide::BUY, 0, 5, OrderType::MARKET));
+
+    trades = book.trades();
+    CHECK(trades.size() == 2);
+    CHECK(trades.size() == 2 && trades[1].sell_order_id == 4);
+}
+
+// A FOK order that cannot fill completely trades nothing and leaves the book as it was
+void test_fok_rejected(BookKind kind) {
+    TestBook book(kind);
+    book->place_limit_order(make_order(1, OrderSide::SELL, 100.00, 5));
+    book->place_limit_order(make_order(2, OrderSide::SELL, 100.01, 5));
+
+    book->place_limit_order(make_order(3, OrderSide::BUY, 100.01, 11, OrderType::FOK));
+
+    CHECK(book.trades().empty());
+    CHECK(book.count_events(3, OrderEvent::FOK_REJECTED) == 1);
+    Level2Data level2 = book->get_level2_data();
+    CHECK(level2.bids.empty());
+    CHECK(level2.asks.size() == 2);
+    CHECK(level2.asks.size() == 2 && level2.asks[0].total_quantity == 5 && level2.asks[1].total_quantity == 5);
+
+    book->place_limit_order(make_order(4, OrderSide::BUY, 100.01, 10, OrderType::FOK));
+    CHECK(book.trades().size() == 2);
+    CHECK(book->get_level2_data().asks.empty());
+}
+
+// A post-only order that would cross is rejected; one that would rest is placed
+void test_post_only_crossing_rejected(BookKind kind) {
+    TestBook book(kind);
+    book->place_limit_order(make_order(1, OrderSide::SELL, 100.00, 5));
+
+    book->place_limit_order(make_order(2, OrderSide::BUY, 100.00, 5, OrderType::POST_ONLY));
+    CHECK(book.trades().empty());
+    CHECK(book.count_events(2, OrderEvent::POST_ONLY_REJECTED) == 1);
+    CHECK(book->get_all_trader_orders(20).empty());
+    Level2Data level2 = book->get_level2_data();
+    CHECK(level2.bids.empty());
+    CHECK(level2.asks.size() == 1 && level2.asks[0].total_quantity == 5);
+
+    book->place_limit_order(make_order(3, OrderSide::BUY, 99.99, 5, OrderType::POST_ONLY));
+    CHECK(book.count_events(3, OrderEvent::LIMIT_PLACED) == 1);
+    CHECK(book->get_level2_data().bids.size() == 1);
+}
+
+// An IOC order trades what it can and the rest is canceled instead of resting
+void test_ioc_remainder_canceled(BookKind kind) {
+    TestBook book(kind);
+    book->place_limit_order(make_order(1, OrderSide::SELL, 100.00, 5));
+
+    book->place_limit_order(make_order(2, OrderSide::BUY, 100.01, 8, OrderType::IOC));
+
+    std::vector<Trade> trades = book.trades();
+    CHECK(trades.size() == 1 && trades[0].quantity == 5 && trades[0].buy_order_id == 2);
+    CHECK(book.count_events(2, OrderEvent::REMAINDER_CANCELED) == 1);
+    for (const OrderLog& log : book.logs()) {
+        if (log.order_id == 2 && log.event == OrderEvent::REMAINDER_CANCELED) {
+            CHECK(log.quantity == 3);
+        }
+    }
+    Level2Data level2 = book->get_level2_data();
+    CHECK(level2.bids.empty());
+    CHECK(level2.asks.empty());
+    CHECK(book->get_all_trader_orders(20).empty());
+}
+
+}  // namespace
+
+int main() {
+    test_order_index_backward_shift_erase();
+    test_order_index_churn();
+
+    for (BookKind kind : {BookKind::MAP, BookKind::LADDER}) {
+        test_modify_queue_position(kind);
+        test_fok_rejected(kind);
+        test_post_only_crossing_rejected(kind);
+        test_ioc_remainder_canceled(kind);
+    }
+
+    if (failures > 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("All order book tests passed\n");
+    return 0;
+}